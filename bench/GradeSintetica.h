@@ -0,0 +1,71 @@
+#ifndef __PROVA_GRADESINTETICA_H_
+#define __PROVA_GRADESINTETICA_H_
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Grade lado x lado numerada por linhas, com custos aleatórios, comum aos benchmarks. Guarda
+// as arestas (v, v + 1) e (v, v + lado), na ordem dos nós, e os vizinhos de cada nó em ordem
+// crescente (acima, esquerda, direita, abaixo), no formato dos LSAs da ArvoreCaminhos:
+// custos[v][k] é o custo do enlace de v até vizinhos[v][k].
+struct GradeSintetica {
+    int numNos;
+    std::vector<std::pair<int, int>> arestas;
+    std::vector<std::vector<int>> vizinhos;
+    std::vector<std::vector<double>> custos;
+};
+
+enum SentidoCustos {
+    CUSTOS_SIMETRICOS,   // Um custo por aresta, igual nos dois sentidos (como os canais do GeradorTopologia)
+    CUSTOS_POR_SENTIDO   // Cada nó sorteia os custos dos seus enlaces (LSAs independentes)
+};
+
+// Custos uniformes em [custoMinimo, custoMaximo). Simétricos: sorteados na ordem das arestas;
+// por sentido: na ordem dos nós e, em cada nó, dos vizinhos
+inline void gerarGrade(GradeSintetica& grade, int lado, double custoMinimo, double custoMaximo, SentidoCustos sentido,
+                       std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> custo(custoMinimo, custoMaximo);
+    grade.numNos = lado * lado;
+    grade.arestas.clear();
+    grade.vizinhos.assign(grade.numNos, std::vector<int>());
+    for (int v = 0; v < grade.numNos; v++) {
+        int linha = v / lado, coluna = v % lado;
+        if (linha > 0) {
+            grade.vizinhos[v].push_back(v - lado);
+        }
+        if (coluna > 0) {
+            grade.vizinhos[v].push_back(v - 1);
+        }
+        if (coluna + 1 < lado) {
+            grade.vizinhos[v].push_back(v + 1);
+            grade.arestas.push_back(std::make_pair(v, v + 1));
+        }
+        if (linha + 1 < lado) {
+            grade.vizinhos[v].push_back(v + lado);
+            grade.arestas.push_back(std::make_pair(v, v + lado));
+        }
+    }
+
+    grade.custos.assign(grade.numNos, std::vector<double>());
+    for (int v = 0; v < grade.numNos; v++) {
+        grade.custos[v].resize(grade.vizinhos[v].size());
+    }
+    if (sentido == CUSTOS_POR_SENTIDO) {
+        for (int v = 0; v < grade.numNos; v++) {
+            for (size_t k = 0; k < grade.custos[v].size(); k++) {
+                grade.custos[v][k] = custo(rng);
+            }
+        }
+        return;
+    }
+    for (size_t i = 0; i < grade.arestas.size(); i++) {
+        int a = grade.arestas[i].first, b = grade.arestas[i].second;
+        double c = custo(rng);
+        grade.custos[a][std::find(grade.vizinhos[a].begin(), grade.vizinhos[a].end(), b) - grade.vizinhos[a].begin()] = c;
+        grade.custos[b][std::find(grade.vizinhos[b].begin(), grade.vizinhos[b].end(), a) - grade.vizinhos[b].begin()] = c;
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Microbenchmark da alocação por evento do PI em modo delta (PoolAlocacao.h), sem o kernel do
+// OMNeT++. Reproduz o vai e vem de um nó de grau 16: cada anúncio recebido é apagado e gera uma
+// confirmação; a cada 16 anúncios recebidos, o nó monta um retrato de alterações (de 1 a 32
+// entradas) e o envia pelas 16 portas. As mensagens em trânsito são entregues em ordem
+// sorteada, como em enlaces de atrasos diferentes. A mensagem sintética tem o operator
+// new/delete da Mensagem (Mensagem.msg).
+// Compilado duas vezes, com e sem PROVA_SEM_POOL, ambas com PROVA_CONTAR_ALOCACOES: mede
+// eventos por segundo e alocações do processo por evento (as do simulador não entram).
+// Independente do OMNeT++; "make bench" (ver makefrag).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "AnuncioTabela.h"
+#include "PoolAlocacao.h"
+
+#ifdef PROVA_SEM_POOL
+static const char *const VERSAO = "sem pool";
+#else
+static const char *const VERSAO = "com pool";
+#endif
+
+static const int GRAU = 16;
+static const int MAXIMO_ENTRADAS = 32;
+
+// Da ordem de uma Mensagem: o cabeçalho do cPacket e os campos de Mensagem.msg
+struct MensagemSintetica {
+    bool confirmacao;
+    int idNoOrigem;
+    AnuncioTabelaPtr anuncio;
+    char restante[192];
+
+    static void *operator new(size_t tamanho) { return ArenaClasses::alocar(tamanho); }
+    static void operator delete(void *bloco, size_t tamanho) { ArenaClasses::liberar(bloco, tamanho); }
+};
+
+struct Rede {
+    std::vector<MensagemSintetica *> emTransito;   // Reservado antes: não aloca em regime
+    std::mt19937_64 rng;
+    int anunciosRecebidos = 0;
+    double soma = 0;   // Lida dos anúncios, para o compilador não descartar o trabalho
+
+    void anunciar(int origem) {
+        std::shared_ptr<AnuncioTabela> anuncio = PoolAnuncios::obter();
+        int n = std::uniform_int_distribution<int>(1, MAXIMO_ENTRADAS)(rng);
+        for (int j = 0; j < n; j++) {
+            anuncio->destinos.push_back(j);
+            anuncio->custos.push_back(0.001 * (j + 1));
+            anuncio->proximosSaltos.push_back(origem);
+        }
+        AnuncioTabelaPtr retrato = anuncio;
+        for (int porta = 0; porta < GRAU; porta++) {
+            MensagemSintetica *msg = new MensagemSintetica();
+            msg->confirmacao = false;
+            msg->idNoOrigem = origem;
+            msg->anuncio = retrato;
+            emTransito.push_back(msg);
+        }
+    }
+
+    // Um evento: entrega uma mensagem em trânsito sorteada
+    void entregar() {
+        size_t i = std::uniform_int_distribution<size_t>(0, emTransito.size() - 1)(rng);
+        MensagemSintetica *msg = emTransito[i];
+        emTransito[i] = emTransito.back();
+        emTransito.pop_back();
+        if (!msg->confirmacao) {
+            const AnuncioTabela& anuncio = *msg->anuncio;
+            for (size_t j = 0; j < anuncio.tamanho(); j++) {
+                soma += anuncio.custos[j];
+            }
+            MensagemSintetica *confirmacao = new MensagemSintetica();
+            confirmacao->confirmacao = true;
+            confirmacao->idNoOrigem = msg->idNoOrigem;
+            emTransito.push_back(confirmacao);
+            if (++anunciosRecebidos % GRAU == 0) {
+                anunciar(msg->idNoOrigem + 1);
+            }
+        }
+        delete msg;
+    }
+};
+
+int main(int argc, char **argv) {
+    long long numEventos = argc > 1 ? atoll(argv[1]) : 20000000;
+    const int anunciosIniciais = 64;
+
+    if (!contandoAlocacoes()) {
+        fprintf(stderr, "compile com -DPROVA_CONTAR_ALOCACOES\n");
+        return 1;
+    }
+    Rede rede;
+    rede.rng.seed(42);
+    rede.emTransito.reserve(anunciosIniciais * GRAU * 4);
+    for (int i = 0; i < anunciosIniciais; i++) {
+        rede.anunciar(i);
+    }
+    // Aquecimento: arena e pool chegam ao pico de objetos vivos
+    for (long long e = 0; e < numEventos / 10; e++) {
+        rede.entregar();
+    }
+
+    uint64_t alocacoesAntes = alocacoesDoProcesso();
+    uint64_t retratosAntes = PoolAnuncios::estatisticas().obtidos;
+    auto inicio = std::chrono::steady_clock::now();
+    for (long long e = 0; e < numEventos; e++) {
+        rede.entregar();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    uint64_t alocacoes = alocacoesDoProcesso() - alocacoesAntes;
+    uint64_t retratos = PoolAnuncios::estatisticas().obtidos - retratosAntes;
+
+    printf("%-8s: %lld eventos (%llu retratos, %zu mensagens em trânsito), %.2f milhões de eventos/s, "
+           "%.3f alocações por evento (soma %.3g)\n",
+           VERSAO, numEventos, (unsigned long long)retratos, rede.emTransito.size(), numEventos / segundos / 1e6,
+           (double)alocacoes / numEventos, rede.soma);
+    return 0;
+}
@@ -0,0 +1,225 @@
+// Microbenchmark da consulta do plano de dados (porta de saída de cada pacote), em grades de
+// 1k a 1M destinos com custos aleatórios, a partir do nó central:
+// - mapa: std::map destino -> porta, como o antigo proximosSaltos;
+// - densa: TabelaRoteamento::proximoSalto + porta do vizinho em unordered_map (o caminho do
+//   Roteador antes da FIB);
+// - plana e intervalos: os dois formatos da TabelaEncaminhamento.
+// Mede consultas por segundo a destinos sorteados e bytes por destino. Depois aplica às FIBs
+// as rotas alteradas por mudanças de custo de enlace (ArvoreCaminhos::tocados()) e mede o
+// custo de cada atualização. No fim, confere as FIBs com a árvore.
+// Independente do OMNeT++; "make bench" (ver makefrag).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "ArvoreCaminhos.h"
+#include "GradeSintetica.h"
+#include "TabelaEncaminhamento.h"
+#include "TabelaRoteamento.h"
+
+// Bytes alocados pelo std::map (nós da árvore, sem o cabeçalho de cada bloco do malloc)
+static size_t bytesMapa = 0;
+
+template <typename T>
+struct AlocadorContado {
+    typedef T value_type;
+    AlocadorContado() {}
+    template <typename U>
+    AlocadorContado(const AlocadorContado<U>&) {}
+    T *allocate(size_t n) {
+        bytesMapa += n * sizeof(T);
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T *bloco, size_t n) {
+        bytesMapa -= n * sizeof(T);
+        ::operator delete(bloco);
+    }
+};
+template <typename T, typename U>
+bool operator==(const AlocadorContado<T>&, const AlocadorContado<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const AlocadorContado<T>&, const AlocadorContado<U>&) { return false; }
+
+typedef std::map<int, int, std::less<int>, AlocadorContado<std::pair<const int, int>>> MapaPortas;
+
+// Porta da raiz (posição do vizinho na lista dela) pela qual a árvore chega ao destino
+static int portaNaArvore(const ArvoreCaminhos& arvore, const GradeSintetica& grade, int destino) {
+    int salto = arvore.primeiroSalto(destino);
+    if (salto == TabelaRoteamento::SEM_ROTA || salto == arvore.raiz()) {
+        return TabelaEncaminhamento::SEM_PORTA;
+    }
+    const std::vector<int>& vizinhos = grade.vizinhos[arvore.raiz()];
+    return std::find(vizinhos.begin(), vizinhos.end(), salto) - vizinhos.begin();
+}
+
+template <typename Consulta>
+static double medirConsultas(const std::vector<int>& destinos, Consulta consulta, long long& soma) {
+    auto inicio = std::chrono::steady_clock::now();
+    soma = 0;
+    for (size_t i = 0; i < destinos.size(); i++) {
+        soma += consulta(destinos[i]);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return destinos.size() / segundos;
+}
+
+struct ConsultaMapa {
+    const MapaPortas *mapa;
+    int operator()(int destino) const {
+        MapaPortas::const_iterator it = mapa->find(destino);
+        return it == mapa->end() ? TabelaEncaminhamento::SEM_PORTA : it->second;
+    }
+};
+
+struct ConsultaDensa {
+    const TabelaRoteamento *tabela;
+    const std::unordered_map<int, int> *portaDoVizinho;
+    int operator()(int destino) const {
+        std::unordered_map<int, int>::const_iterator it = portaDoVizinho->find(tabela->proximoSalto(destino));
+        return it == portaDoVizinho->end() ? TabelaEncaminhamento::SEM_PORTA : it->second;
+    }
+};
+
+struct ConsultaFib {
+    const TabelaEncaminhamento *fib;
+    int operator()(int destino) const { return fib->porta(destino); }
+};
+
+static bool conferir(const TabelaEncaminhamento& fib, const ArvoreCaminhos& arvore, const GradeSintetica& grade) {
+    for (int v = 0; v < grade.numNos; v++) {
+        if (fib.porta(v) != portaNaArvore(arvore, grade, v)) {
+            fprintf(stderr, "FIB %s divergiu da árvore no destino %d\n",
+                    fib.formato() == TabelaEncaminhamento::FORMATO_PLANO ? "plana" : "por intervalos", v);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::vector<int> lados = {32, 100, 317, 1000};
+    if (argc > 1) {
+        lados.clear();
+        for (int i = 1; i < argc; i++) {
+            lados.push_back(atoi(argv[i]));
+        }
+    }
+    const size_t numConsultas = 4000000;
+    const int numAlteracoes = 200;
+
+    std::mt19937_64 rng(42);
+    printf("%8s %10s | %-31s | %-35s | %s\n", "", "", "bytes por destino", "milhões de consultas/s",
+           "atualização (ns/rota)");
+    printf("%8s %10s | %7s %7s %7s %7s | %8s %8s %8s %8s | %9s %9s\n", "nós", "intervalos", "mapa", "densa",
+           "plana", "interv.", "mapa", "densa", "plana", "interv.", "plana", "interv.");
+    for (int lado : lados) {
+        GradeSintetica grade;
+        gerarGrade(grade, lado, 0.001, 0.01, CUSTOS_POR_SENTIDO, rng);
+        int raiz = (lado / 2) * lado + lado / 2;
+        ArvoreCaminhos arvore;
+        arvore.reiniciar(raiz);
+        for (int v = 0; v < grade.numNos; v++) {
+            arvore.substituir(v, grade.vizinhos[v].data(), grade.custos[v].data(), grade.vizinhos[v].size());
+        }
+        arvore.recalcular();
+        arvore.limparTocados();
+
+        // As quatro estruturas com as rotas da raiz
+        bytesMapa = 0;
+        MapaPortas mapa;
+        TabelaRoteamento tabela;
+        std::unordered_map<int, int> portaDoVizinho;
+        TabelaEncaminhamento plana, intervalos;
+        plana.configurar(TabelaEncaminhamento::FORMATO_PLANO);
+        intervalos.configurar(TabelaEncaminhamento::FORMATO_INTERVALOS);
+        for (size_t k = 0; k < grade.vizinhos[raiz].size(); k++) {
+            portaDoVizinho[grade.vizinhos[raiz][k]] = k;
+        }
+        for (int v = 0; v < grade.numNos; v++) {
+            tabela.definir(v, arvore.distancia(v), arvore.primeiroSalto(v));
+            int porta = portaNaArvore(arvore, grade, v);
+            if (porta != TabelaEncaminhamento::SEM_PORTA) {
+                mapa[v] = porta;
+            }
+            plana.definir(v, porta);
+            intervalos.definir(v, porta);
+        }
+
+        std::vector<int> destinos(numConsultas);
+        std::uniform_int_distribution<int> sorteio(0, grade.numNos - 1);
+        for (size_t i = 0; i < destinos.size(); i++) {
+            destinos[i] = sorteio(rng);
+        }
+        long long somas[4];
+        ConsultaMapa consultaMapa = {&mapa};
+        ConsultaDensa consultaDensa = {&tabela, &portaDoVizinho};
+        ConsultaFib consultaPlana = {&plana};
+        ConsultaFib consultaIntervalos = {&intervalos};
+        double taxaMapa = medirConsultas(destinos, consultaMapa, somas[0]);
+        double taxaDensa = medirConsultas(destinos, consultaDensa, somas[1]);
+        double taxaPlana = medirConsultas(destinos, consultaPlana, somas[2]);
+        double taxaIntervalos = medirConsultas(destinos, consultaIntervalos, somas[3]);
+        if (somas[0] != somas[1] || somas[0] != somas[2] || somas[0] != somas[3]) {
+            fprintf(stderr, "consultas divergentes (%d nós): %lld %lld %lld %lld\n", grade.numNos, somas[0], somas[1],
+                    somas[2], somas[3]);
+            return 1;
+        }
+        size_t numIntervalos = intervalos.numIntervalos();
+        double bytesPlana = (double)plana.bytesOcupados() / grade.numNos;
+        double bytesIntervalos = (double)intervalos.bytesOcupados() / grade.numNos;
+
+        // Mudanças de custo em enlaces sorteados (metade para mais, metade para menos); cada
+        // destino tocado pelo SPF incremental é reescrito nas duas FIBs
+        std::uniform_int_distribution<int> sorteioNo(0, grade.numNos - 1);
+        std::uniform_real_distribution<double> fator(1.5, 4.0);
+        double segundosPlana = 0, segundosIntervalos = 0;
+        size_t rotasTocadas = 0;
+        std::vector<int> portas;
+        for (int i = 0; i < numAlteracoes; i++) {
+            int origem = sorteioNo(rng);
+            std::vector<double>& custos = grade.custos[origem];
+            size_t k = std::uniform_int_distribution<size_t>(0, custos.size() - 1)(rng);
+            custos[k] = (i % 2 == 0) ? custos[k] * fator(rng) : custos[k] / fator(rng);
+            arvore.atualizar(origem, grade.vizinhos[origem].data(), custos.data(), custos.size());
+
+            const std::vector<int>& tocados = arvore.tocados();
+            portas.resize(tocados.size());
+            for (size_t j = 0; j < tocados.size(); j++) {
+                portas[j] = portaNaArvore(arvore, grade, tocados[j]);
+            }
+            auto inicio = std::chrono::steady_clock::now();
+            for (size_t j = 0; j < tocados.size(); j++) {
+                plana.definir(tocados[j], portas[j]);
+            }
+            auto meio = std::chrono::steady_clock::now();
+            for (size_t j = 0; j < tocados.size(); j++) {
+                intervalos.definir(tocados[j], portas[j]);
+            }
+            auto fim = std::chrono::steady_clock::now();
+            segundosPlana += std::chrono::duration<double>(meio - inicio).count();
+            segundosIntervalos += std::chrono::duration<double>(fim - meio).count();
+            rotasTocadas += tocados.size();
+            arvore.limparTocados();
+        }
+        if (!conferir(plana, arvore, grade) || !conferir(intervalos, arvore, grade)) {
+            return 1;
+        }
+        if (plana.numIntervalos() != intervalos.numIntervalos()) {
+            fprintf(stderr, "número de intervalos divergente: %zu (plana) x %zu\n", plana.numIntervalos(),
+                    intervalos.numIntervalos());
+            return 1;
+        }
+
+        printf("%8d %10zu | %7.1f %7.1f %7.2f %7.3f | %8.1f %8.1f %8.1f %8.1f | %9.1f %9.1f\n", grade.numNos,
+               numIntervalos, (double)bytesMapa / grade.numNos, (double)tabela.bytesOcupados() / grade.numNos,
+               bytesPlana, bytesIntervalos, taxaMapa / 1e6, taxaDensa / 1e6, taxaPlana / 1e6, taxaIntervalos / 1e6,
+               rotasTocadas > 0 ? segundosPlana * 1e9 / rotasTocadas : 0.0,
+               rotasTocadas > 0 ? segundosIntervalos * 1e9 / rotasTocadas : 0.0);
+    }
+    return 0;
+}
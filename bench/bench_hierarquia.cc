@@ -0,0 +1,171 @@
+// Benchmark do roteamento hierárquico (tamanhoArea): memória das tabelas de todos os nós e
+// estiramento das rotas (custo encaminhado / ótimo) em relação às tabelas planas, em grades
+// de 10k e 100k nós com custos aleatórios. As tabelas são montadas no estado a que o vetor de
+// distâncias converge: rotas internas pelo caminho mínimo dentro da área e, para as demais
+// áreas, pelo caminho mínimo até o nó mais próximo da área. As áreas vêm da ParticaoAreas,
+// como no GeradorTopologia, e as rotas de todas as origens para uma amostra de destinos são
+// seguidas salto a salto pelo ValidadorRoteamento.
+// Independente do OMNeT++; "make bench" (ver makefrag).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+#include "GradeSintetica.h"
+#include "ParticaoAreas.h"
+#include "TabelaRoteamento.h"
+#include "ValidadorRoteamento.h"
+
+// Dijkstra a partir das origens (distância 0), só pelos nós com permitido[v] (ou todos, se
+// vazio). proximos[v] é o vizinho de v no caminho até a origem mais próxima (v, nas origens)
+static void dijkstra(const GradeSintetica& grade, const std::vector<int>& origens, const std::vector<unsigned char>& permitido,
+                     std::vector<double>& distancias, std::vector<int>& proximos, std::vector<int>& alcancados) {
+    typedef std::pair<double, int> Item;
+    std::vector<Item> heap;
+    std::greater<Item> maior;
+    for (size_t k = 0; k < origens.size(); k++) {
+        distancias[origens[k]] = 0;
+        proximos[origens[k]] = origens[k];
+        heap.push_back(Item(0.0, origens[k]));
+        alcancados.push_back(origens[k]);
+    }
+    std::make_heap(heap.begin(), heap.end(), maior);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), maior);
+        Item item = heap.back();
+        heap.pop_back();
+        int v = item.second;
+        if (item.first > distancias[v]) {
+            continue;
+        }
+        for (size_t k = 0; k < grade.vizinhos[v].size(); k++) {
+            int u = grade.vizinhos[v][k];
+            double candidato = item.first + grade.custos[v][k];
+            if ((permitido.empty() || permitido[u]) && candidato < distancias[u]) {
+                if (distancias[u] == TabelaRoteamento::CUSTO_INFINITO) {
+                    alcancados.push_back(u);
+                }
+                distancias[u] = candidato;
+                proximos[u] = v;
+                heap.push_back(Item(candidato, u));
+                std::push_heap(heap.begin(), heap.end(), maior);
+            }
+        }
+    }
+}
+
+// Tabelas convergidas de todos os nós (indexadas pelo nó; os índices das entradas seguem o
+// Roteador: endereço % tamanhoArea na própria área, tamanhoArea + área para as demais)
+static void montarTabelas(const GradeSintetica& grade, const std::vector<int>& enderecos, int tamanhoArea, int numAreas,
+                          std::vector<TabelaRoteamento>& tabelas) {
+    std::vector<std::vector<int>> membros(numAreas);
+    for (int v = 0; v < grade.numNos; v++) {
+        membros[enderecos[v] / tamanhoArea].push_back(v);
+    }
+    std::vector<double> distancias(grade.numNos, TabelaRoteamento::CUSTO_INFINITO);
+    std::vector<int> proximos(grade.numNos, -1);
+    std::vector<int> alcancados;
+    std::vector<unsigned char> naArea(grade.numNos, 0);
+    std::vector<unsigned char> todos;
+
+    for (int area = 0; area < numAreas; area++) {
+        // Rotas internas: cada destino da área, pelos nós da área. Com custos simétricos, o
+        // vizinho no caminho de volta é o próximo salto de ida
+        for (size_t i = 0; i < membros[area].size(); i++) {
+            naArea[membros[area][i]] = 1;
+        }
+        for (size_t i = 0; i < membros[area].size(); i++) {
+            int destino = membros[area][i];
+            alcancados.clear();
+            dijkstra(grade, std::vector<int>(1, destino), naArea, distancias, proximos, alcancados);
+            for (size_t k = 0; k < alcancados.size(); k++) {
+                int v = alcancados[k];
+                tabelas[v].definir(enderecos[destino] % tamanhoArea, distancias[v], enderecos[proximos[v]]);
+                distancias[v] = TabelaRoteamento::CUSTO_INFINITO;
+            }
+        }
+        for (size_t i = 0; i < membros[area].size(); i++) {
+            naArea[membros[area][i]] = 0;
+        }
+
+        // Entrada resumida da área em toda a rede: caminho mínimo até o nó mais próximo dela
+        alcancados.clear();
+        dijkstra(grade, membros[area], todos, distancias, proximos, alcancados);
+        for (size_t k = 0; k < alcancados.size(); k++) {
+            int v = alcancados[k];
+            tabelas[v].definir(tamanhoArea + area, distancias[v], enderecos[proximos[v]]);
+            distancias[v] = TabelaRoteamento::CUSTO_INFINITO;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    // Pares lado:tamanhoArea
+    std::vector<std::pair<int, int>> casos = {{100, 100}, {317, 316}};
+    if (argc > 1) {
+        casos.clear();
+        for (int i = 1; i < argc; i++) {
+            int lado, tamanhoArea;
+            if (sscanf(argv[i], "%d:%d", &lado, &tamanhoArea) != 2 || lado <= 0 || tamanhoArea <= 0) {
+                fprintf(stderr, "uso: %s [lado:tamanhoArea ...]\n", argv[0]);
+                return 2;
+            }
+            casos.push_back(std::make_pair(lado, tamanhoArea));
+        }
+    }
+    const size_t numDestinos = 64;
+
+    std::mt19937_64 rng(42);
+    printf("%8s %6s %6s %9s %11s %12s %12s %8s %10s %10s %10s %8s\n", "nós", "área", "áreas", "entradas",
+           "capacidade", "hierárq(MB)", "plana(MB)", "razão", "estir.méd", "estir.máx", "subótimas", "tempo(s)");
+    for (size_t c = 0; c < casos.size(); c++) {
+        int tamanhoArea = casos[c].second;
+        // Custos simétricos, como os canais do GeradorTopologia
+        GradeSintetica grade;
+        gerarGrade(grade, casos[c].first, 0.001, 0.005, CUSTOS_SIMETRICOS, rng);
+        auto inicio = std::chrono::steady_clock::now();
+
+        std::vector<int> enderecos;
+        int numAreas = ParticaoAreas::numerar(grade.numNos, grade.arestas, tamanhoArea, enderecos);
+        std::vector<TabelaRoteamento> tabelas(grade.numNos);
+        montarTabelas(grade, enderecos, tamanhoArea, numAreas, tabelas);
+
+        uint64_t bytesHierarquicos = 0;
+        size_t maisEntradas = 0, maiorCapacidade = 0;
+        for (int v = 0; v < grade.numNos; v++) {
+            bytesHierarquicos += tabelas[v].bytesOcupados();
+            maisEntradas = std::max(maisEntradas, tabelas[v].tamanho());
+            maiorCapacidade = std::max(maiorCapacidade, tabelas[v].capacidade());
+        }
+        // Plana: uma entrada por nó da rede em cada tabela
+        TabelaRoteamento plana;
+        plana.reservar(grade.numNos - 1);
+        double bytesPlanos = (double)plana.bytesOcupados() * grade.numNos;
+
+        ValidadorRoteamento validador;
+        for (int v = 0; v < grade.numNos; v++) {
+            validador.adicionarNo(enderecos[v], &tabelas[v]);
+            for (size_t k = 0; k < grade.vizinhos[v].size(); k++) {
+                validador.adicionarEnlace(enderecos[v], enderecos[grade.vizinhos[v][k]], grade.custos[v][k]);
+            }
+        }
+        validador.definirAreas(tamanhoArea);
+        validador.amostrarDestinos(numDestinos);
+        ValidadorRoteamento::Resultado resultado = validador.validar();
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        if (resultado.rotasEmLaco > 0 || resultado.rotasInterrompidas > 0) {
+            fprintf(stderr, "rotas hierárquicas incorretas (%d nós, tamanhoArea %d): %lld em laço, %lld interrompidas\n",
+                    grade.numNos, tamanhoArea, (long long)resultado.rotasEmLaco, (long long)resultado.rotasInterrompidas);
+            return 1;
+        }
+        printf("%8d %6d %6d %9zu %11zu %12.1f %12.1f %7.0fx %10.3f %10.2f %9.1f%% %8.1f\n", grade.numNos, tamanhoArea,
+               numAreas, maisEntradas, maiorCapacidade, bytesHierarquicos / 1e6, bytesPlanos / 1e6, bytesPlanos / bytesHierarquicos,
+               resultado.estiramentoMedio(), resultado.maiorEstiramento,
+               100.0 * resultado.rotasSubotimas / resultado.rotasVerificadas, segundos);
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+// Benchmark dos kernels de relaxação da TabelaRoteamento (escalar x AVX2 x AVX-512)
+// para tabelas de 8 a 100k destinos. Independente do OMNeT++; "make bench" (ver makefrag).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "TabelaRoteamento.h"
+
+static const TabelaRoteamento::Kernel KERNELS[] = {
+    TabelaRoteamento::KERNEL_ESCALAR, TabelaRoteamento::KERNEL_AVX2, TabelaRoteamento::KERNEL_AVX512
+};
+
+struct MensagemSintetica {
+    std::vector<int> destinos;
+    std::vector<double> custos;
+    std::vector<int> proximosSaltos;   // Próximo salto do vizinho em cada entrada (horizonte dividido)
+};
+
+static MensagemSintetica gerarMensagem(int numDestinos, bool embaralhada, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> custo(0.001, 0.1);
+    MensagemSintetica msg;
+    for (int d = 0; d < numDestinos; d++) {
+        msg.destinos.push_back(d);
+        msg.custos.push_back(custo(rng));
+    }
+    // Anúncios completos saem em ordem crescente; deltas podem vir em qualquer ordem
+    if (embaralhada) {
+        std::shuffle(msg.destinos.begin(), msg.destinos.end(), rng);
+    }
+    return msg;
+}
+
+// Aplica as mensagens em ordem, a mensagem k vinda do vizinho k. Com filtrar, cada entrada
+// cujo próximo salto no vizinho é o nó 0 é ignorada, como no horizonte dividido
+static void aplicar(TabelaRoteamento& t, const std::vector<MensagemSintetica>& mensagens, bool filtrar,
+                    std::vector<int>& alterados) {
+    for (size_t k = 0; k < mensagens.size(); k++) {
+        t.relaxar(mensagens[k].destinos.data(), mensagens[k].custos.data(), mensagens[k].destinos.size(),
+                  0.01 * (k % 4), (int)k, alterados, filtrar ? mensagens[k].proximosSaltos.data() : nullptr, 0);
+    }
+}
+
+// Todos os kernels devem produzir a mesma tabela e o mesmo conjunto de alterados, com e sem
+// o filtro de próximo salto
+static bool conferirKernels(std::mt19937_64& rng) {
+    std::vector<MensagemSintetica> mensagens;
+    for (int k = 0; k < 16; k++) {
+        mensagens.push_back(gerarMensagem(1 + (int)(rng() % 1000), k % 2 == 1, rng));
+    }
+    // Destinos repetidos dentro de um mesmo bloco de lanes
+    MensagemSintetica repetida;
+    for (int k = 0; k < 37; k++) {
+        repetida.destinos.push_back(k % 3);
+        repetida.custos.push_back(1.0 - k * 0.01);
+    }
+    mensagens.push_back(repetida);
+    // Um quarto das entradas passa pelo nó 0 e é descartada quando o filtro está ligado
+    for (size_t k = 0; k < mensagens.size(); k++) {
+        for (size_t i = 0; i < mensagens[k].destinos.size(); i++) {
+            mensagens[k].proximosSaltos.push_back((int)(rng() % 4));
+        }
+    }
+
+    for (int filtrar = 0; filtrar < 2; filtrar++) {
+        TabelaRoteamento referencia;
+        referencia.usarKernel(TabelaRoteamento::KERNEL_ESCALAR);
+        std::vector<int> alteradosReferencia;
+        aplicar(referencia, mensagens, filtrar, alteradosReferencia);
+        if (filtrar) {
+            // O filtro precisa ter descartado melhorias, ou o caso não exercita nada
+            TabelaRoteamento semFiltro;
+            semFiltro.usarKernel(TabelaRoteamento::KERNEL_ESCALAR);
+            std::vector<int> alteradosSemFiltro;
+            aplicar(semFiltro, mensagens, false, alteradosSemFiltro);
+            if (alteradosSemFiltro == alteradosReferencia) {
+                fprintf(stderr, "o filtro de próximo salto não descartou nenhuma melhoria\n");
+                return false;
+            }
+        }
+        for (TabelaRoteamento::Kernel kernel : KERNELS) {
+            if (!TabelaRoteamento::kernelSuportado(kernel)) {
+                continue;
+            }
+            const char *caso = filtrar ? " com filtro de próximo salto" : "";
+            TabelaRoteamento t;
+            t.usarKernel(kernel);
+            std::vector<int> alterados;
+            aplicar(t, mensagens, filtrar, alterados);
+            if (alterados != alteradosReferencia || t.tamanho() != referencia.tamanho()) {
+                fprintf(stderr, "kernel %s divergiu do escalar%s\n", TabelaRoteamento::nomeKernel(kernel), caso);
+                return false;
+            }
+            for (int d = referencia.primeiro(); d != TabelaRoteamento::SEM_ROTA; d = referencia.seguinte(d)) {
+                if (t.custo(d) != referencia.custo(d) || t.proximoSalto(d) != referencia.proximoSalto(d)) {
+                    fprintf(stderr, "kernel %s divergiu do escalar no destino %d%s\n", TabelaRoteamento::nomeKernel(kernel),
+                            d, caso);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Regime estável: a tabela já contém o mínimo e nenhuma entrada melhora, que é o caso
+// dominante na propagação. Retorna nanossegundos por mensagem.
+static double medir(TabelaRoteamento::Kernel kernel, const MensagemSintetica& msg, size_t& verificacao) {
+    TabelaRoteamento t;
+    t.usarKernel(kernel);
+    std::vector<int> alterados;
+    t.relaxar(msg.destinos.data(), msg.custos.data(), msg.destinos.size(), 0.01, 1, alterados);
+
+    long iteracoes = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    double decorrido;
+    do {
+        for (int k = 0; k < 64; k++) {
+            alterados.clear();
+            verificacao += t.relaxar(msg.destinos.data(), msg.custos.data(), msg.destinos.size(), 0.01, 2, alterados);
+        }
+        iteracoes += 64;
+        decorrido = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+    } while (decorrido < 1e8);
+    return decorrido / iteracoes;
+}
+
+int main(int argc, char **argv) {
+    std::vector<int> tamanhos = {8, 64, 512, 4096, 32768, 100000};
+    if (argc > 1) {
+        tamanhos.clear();
+        for (int i = 1; i < argc; i++) {
+            tamanhos.push_back(atoi(argv[i]));
+        }
+    }
+
+    std::mt19937_64 rng(42);
+    if (!conferirKernels(rng)) {
+        return 1;
+    }
+    printf("kernel padrão nesta CPU: %s\n", TabelaRoteamento::nomeKernel(TabelaRoteamento::melhorKernel()));
+
+    size_t verificacao = 0;
+    printf("%10s %11s", "destinos", "ordem");
+    for (TabelaRoteamento::Kernel kernel : KERNELS) {
+        printf(" %14s", (std::string(TabelaRoteamento::nomeKernel(kernel)) + "(ns)").c_str());
+    }
+    printf(" %9s\n", "ganho");
+    for (int n : tamanhos) {
+        for (int embaralhada = 0; embaralhada < 2; embaralhada++) {
+            MensagemSintetica msg = gerarMensagem(n, embaralhada, rng);
+            printf("%10d %11s", n, embaralhada ? "embaralhada" : "crescente");
+            double escalar = 0, melhor = 0;
+            for (TabelaRoteamento::Kernel kernel : KERNELS) {
+                if (!TabelaRoteamento::kernelSuportado(kernel)) {
+                    printf(" %14s", "-");
+                    continue;
+                }
+                double ns = medir(kernel, msg, verificacao);
+                if (kernel == TabelaRoteamento::KERNEL_ESCALAR) {
+                    escalar = ns;
+                }
+                melhor = ns;
+                printf(" %14.1f", ns);
+            }
+            printf(" %8.2fx\n", escalar / melhor);
+        }
+    }
+    fprintf(stderr, "verificacao: %zu\n", verificacao);
+    return 0;
+}
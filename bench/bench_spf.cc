@@ -0,0 +1,126 @@
+// Benchmark do SPF do motor de estado de enlace (ArvoreCaminhos): tempo por atualização de
+// LSA com a correção incremental da árvore x Dijkstra completo, em grades de 1k a 100k nós
+// com custos aleatórios. Cada atualização troca o custo de um enlace sorteado (metade das
+// vezes para mais, metade para menos) no LSA da sua origem. Antes de medir, confere a
+// árvore incremental com o cálculo completo após cada atualização.
+// Independente do OMNeT++; "make bench" (ver makefrag).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "ArvoreCaminhos.h"
+#include "GradeSintetica.h"
+
+static void carregar(ArvoreCaminhos& arvore, const GradeSintetica& grade, int raiz) {
+    arvore.reiniciar(raiz);
+    for (int v = 0; v < grade.numNos; v++) {
+        arvore.substituir(v, grade.vizinhos[v].data(), grade.custos[v].data(), grade.vizinhos[v].size());
+    }
+    arvore.recalcular();
+    arvore.limparTocados();
+}
+
+// Sorteia um enlace e o novo custo, alternando pioras e melhorias
+static int sortearAlteracao(GradeSintetica& grade, std::mt19937_64& rng, int i) {
+    std::uniform_int_distribution<int> sorteioNo(0, grade.numNos - 1);
+    std::uniform_real_distribution<double> fator(1.5, 4.0);
+    int origem = sorteioNo(rng);
+    std::vector<double>& custos = grade.custos[origem];
+    size_t k = std::uniform_int_distribution<size_t>(0, custos.size() - 1)(rng);
+    custos[k] = (i % 2 == 0) ? custos[k] * fator(rng) : custos[k] / fator(rng);
+    return origem;
+}
+
+static bool conferirIncremental(std::mt19937_64& rng) {
+    GradeSintetica grade;
+    gerarGrade(grade, 24, 0.001, 0.01, CUSTOS_POR_SENTIDO, rng);
+    ArvoreCaminhos arvore;
+    carregar(arvore, grade, 0);
+    for (int i = 0; i < 2000; i++) {
+        int origem = sortearAlteracao(grade, rng, i);
+        arvore.atualizar(origem, grade.vizinhos[origem].data(), grade.custos[origem].data(),
+                         grade.vizinhos[origem].size());
+        int divergente;
+        if (!arvore.conferir(divergente)) {
+            fprintf(stderr, "árvore incremental divergiu no nó %d após %d atualizações\n", divergente, i + 1);
+            return false;
+        }
+    }
+    // Todos os enlaces de um nó removidos e recolocados (LSA vazio e de volta)
+    int origem = grade.numNos / 2;
+    arvore.atualizar(origem, nullptr, nullptr, 0);
+    int divergente;
+    bool correta = arvore.conferir(divergente);
+    arvore.atualizar(origem, grade.vizinhos[origem].data(), grade.custos[origem].data(), grade.vizinhos[origem].size());
+    if (!correta || !arvore.conferir(divergente)) {
+        fprintf(stderr, "árvore incremental divergiu no nó %d ao remover o LSA do nó %d\n", divergente, origem);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::vector<int> lados = {32, 100, 317};
+    if (argc > 1) {
+        lados.clear();
+        for (int i = 1; i < argc; i++) {
+            lados.push_back(atoi(argv[i]));
+        }
+    }
+
+    std::mt19937_64 rng(42);
+    if (!conferirIncremental(rng)) {
+        return 1;
+    }
+
+    double verificacao = 0;
+    printf("%8s %14s %14s %10s %16s %16s\n", "nós", "completo(µs)", "incremental(µs)", "ganho",
+           "nós processados", "nós invalidados");
+    for (int lado : lados) {
+        GradeSintetica grade;
+        gerarGrade(grade, lado, 0.001, 0.01, CUSTOS_POR_SENTIDO, rng);
+        ArvoreCaminhos arvore;
+        carregar(arvore, grade, 0);
+
+        // O completo custa o mesmo a cada atualização: bastam poucas
+        int numCompleto = std::max(20, 2000000 / grade.numNos);
+        std::mt19937_64 sorteio(7);
+        auto inicio = std::chrono::steady_clock::now();
+        for (int i = 0; i < numCompleto; i++) {
+            int origem = sortearAlteracao(grade, sorteio, i);
+            arvore.substituir(origem, grade.vizinhos[origem].data(), grade.custos[origem].data(),
+                              grade.vizinhos[origem].size());
+            arvore.recalcular();
+            arvore.limparTocados();
+        }
+        double completo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count() / numCompleto;
+        verificacao += arvore.distancia(grade.numNos - 1);
+
+        int numIncremental = 20000;
+        ArvoreCaminhos::Estatisticas antes = arvore.estatisticas();
+        inicio = std::chrono::steady_clock::now();
+        for (int i = 0; i < numIncremental; i++) {
+            int origem = sortearAlteracao(grade, sorteio, i);
+            arvore.atualizar(origem, grade.vizinhos[origem].data(), grade.custos[origem].data(),
+                             grade.vizinhos[origem].size());
+            arvore.limparTocados();
+        }
+        double incremental = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count() / numIncremental;
+        verificacao += arvore.distancia(grade.numNos - 1);
+
+        const ArvoreCaminhos::Estatisticas& depois = arvore.estatisticas();
+        int divergente;
+        if (!arvore.conferir(divergente)) {
+            fprintf(stderr, "árvore incremental divergiu no nó %d (%d nós)\n", divergente, grade.numNos);
+            return 1;
+        }
+        printf("%8d %14.1f %14.2f %9.0fx %16.1f %16.1f\n", grade.numNos, completo * 1e6, incremental * 1e6,
+               completo / incremental, (double)(depois.nosProcessados - antes.nosProcessados) / numIncremental,
+               (double)(depois.nosInvalidados - antes.nosInvalidados) / numIncremental);
+    }
+    fprintf(stderr, "verificacao: %g\n", verificacao);
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Microbenchmark do processamento de uma mensagem de propagação pelo Roteador:
+// tabela baseada em std::map (implementação anterior) x TabelaRoteamento densa.
+// Independente do OMNeT++; compile com "make bench" (ver makefrag).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+#include "TabelaRoteamento.h"
+
+struct MensagemSintetica {
+    std::vector<int> destinos;
+    std::vector<double> custos;
+};
+
+// Réplica do laço anterior de Roteador::processarInformacaoRecebida
+struct TabelaMapa {
+    std::map<int, double> tabelaRoteamento;
+    std::map<int, int> proximosSaltos;
+    std::vector<int> destinosConhecidos;
+
+    size_t processar(const MensagemSintetica& msg, double custoAteVizinho, int vizinho) {
+        std::map<int, double> tabelaVizinho;
+        for (size_t i = 0; i < msg.destinos.size(); i++) {
+            tabelaVizinho[msg.destinos[i]] = msg.custos[i];
+        }
+        size_t alterados = 0;
+        for (std::map<int, double>::const_iterator it = tabelaVizinho.begin();
+             it != tabelaVizinho.end(); ++it) {
+            double novoCusto = custoAteVizinho + it->second;
+            if (tabelaRoteamento.find(it->first) == tabelaRoteamento.end() ||
+                novoCusto < tabelaRoteamento[it->first]) {
+                tabelaRoteamento[it->first] = novoCusto;
+                proximosSaltos[it->first] = vizinho;
+                alterados++;
+                bool encontrado = false;
+                for (size_t k = 0; k < destinosConhecidos.size(); k++) {
+                    if (destinosConhecidos[k] == it->first) {
+                        encontrado = true;
+                        break;
+                    }
+                }
+                if (!encontrado) {
+                    destinosConhecidos.push_back(it->first);
+                }
+            }
+        }
+        return alterados;
+    }
+};
+
+struct TabelaDensa {
+    TabelaRoteamento tabela;
+    std::vector<int> alterados;
+
+    size_t processar(const MensagemSintetica& msg, double custoAteVizinho, int vizinho) {
+        alterados.clear();
+        return tabela.relaxar(msg.destinos.data(), msg.custos.data(), msg.destinos.size(),
+                              custoAteVizinho, vizinho, alterados);
+    }
+};
+
+static std::vector<MensagemSintetica> gerarMensagens(int numDestinos, int quantidade, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> custo(0.001, 0.1);
+    std::vector<MensagemSintetica> mensagens(quantidade);
+    for (MensagemSintetica& msg : mensagens) {
+        for (int d = 0; d < numDestinos; d++) {
+            msg.destinos.push_back(d);
+            msg.custos.push_back(custo(rng));
+        }
+        // Anúncios chegam em ordem arbitrária
+        std::shuffle(msg.destinos.begin(), msg.destinos.end(), rng);
+    }
+    return mensagens;
+}
+
+// Regime estável: a tabela já conhece todos os destinos e quase nada melhora.
+// Retorna nanossegundos por mensagem.
+template <typename Tabela>
+static double medirEstavel(const std::vector<MensagemSintetica>& mensagens, size_t& verificacao) {
+    Tabela t;
+    for (const MensagemSintetica& msg : mensagens) {
+        verificacao += t.processar(msg, 0.01, 1);
+    }
+    long iteracoes = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    double decorrido;
+    do {
+        for (const MensagemSintetica& msg : mensagens) {
+            verificacao += t.processar(msg, 0.01, 1);
+        }
+        iteracoes += mensagens.size();
+        decorrido = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+    } while (decorrido < 2e8);
+    return decorrido / iteracoes;
+}
+
+// Primeira mensagem: tabela vazia, todas as entradas são novas
+template <typename Tabela>
+static double medirInicial(const std::vector<MensagemSintetica>& mensagens, size_t& verificacao) {
+    long iteracoes = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    double decorrido;
+    do {
+        for (const MensagemSintetica& msg : mensagens) {
+            Tabela t;
+            verificacao += t.processar(msg, 0.01, 1);
+        }
+        iteracoes += mensagens.size();
+        decorrido = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+    } while (decorrido < 2e8);
+    return decorrido / iteracoes;
+}
+
+int main(int argc, char **argv) {
+    std::vector<int> tamanhos = {8, 64, 512, 4096, 32768};
+    if (argc > 1) {
+        tamanhos.clear();
+        for (int i = 1; i < argc; i++) {
+            tamanhos.push_back(atoi(argv[i]));
+        }
+    }
+
+    std::mt19937_64 rng(42);
+    size_t verificacao = 0;
+    printf("%10s %18s %18s %9s %18s %18s %9s\n", "destinos", "map estavel(ns)", "densa estavel(ns)", "ganho",
+           "map inicial(ns)", "densa inicial(ns)", "ganho");
+    for (int n : tamanhos) {
+        std::vector<MensagemSintetica> mensagens = gerarMensagens(n, 8, rng);
+        double mapaEstavel = medirEstavel<TabelaMapa>(mensagens, verificacao);
+        double densaEstavel = medirEstavel<TabelaDensa>(mensagens, verificacao);
+        // O laço antigo é quadrático na inserção (destinosConhecidos); limita o caso inicial
+        double mapaInicial = n <= 4096 ? medirInicial<TabelaMapa>(mensagens, verificacao) : 0;
+        double densaInicial = medirInicial<TabelaDensa>(mensagens, verificacao);
+        printf("%10d %18.1f %18.1f %8.1fx", n, mapaEstavel, densaEstavel, mapaEstavel / densaEstavel);
+        if (mapaInicial > 0) {
+            printf(" %18.1f %18.1f %8.1fx\n", mapaInicial, densaInicial, mapaInicial / densaInicial);
+        } else {
+            printf(" %18s %18.1f %9s\n", "-", densaInicial, "-");
+        }
+    }
+    // Impede que o compilador elimine o trabalho medido
+    fprintf(stderr, "verificacao: %zu\n", verificacao);
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Benchmark da validação global das rotas (ValidadorRoteamento) em grades de 1k a 4k nós,
+// com 1 thread e com todos os núcleos. As tabelas densas de todos os nós crescem com N²,
+// então o tamanho é limitado pela memória das tabelas, não pelo validador: o custo por
+// destino (um Dijkstra e um percurso dos próximos saltos) é O(E log N), e a projeção
+// para 100k nós é impressa ao final. Independente do OMNeT++; "make bench" (ver makefrag).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+#include "GradeSintetica.h"
+#include "TabelaRoteamento.h"
+#include "ValidadorRoteamento.h"
+
+// Tabelas ótimas da grade (custos simétricos), calculadas por um Dijkstra reverso por destino
+static void calcularTabelas(const GradeSintetica& grade, std::vector<TabelaRoteamento>& tabelas) {
+    tabelas.assign(grade.numNos, TabelaRoteamento());
+    for (int v = 0; v < grade.numNos; v++) {
+        tabelas[v].reservar(grade.numNos - 1);
+    }
+    std::vector<double> distancias(grade.numNos);
+    std::vector<int> saltos(grade.numNos);
+    std::vector<std::pair<double, int>> heap;
+    std::greater<std::pair<double, int>> maior;
+    for (int destino = 0; destino < grade.numNos; destino++) {
+        std::fill(distancias.begin(), distancias.end(), TabelaRoteamento::CUSTO_INFINITO);
+        distancias[destino] = 0;
+        saltos[destino] = destino;
+        heap.assign(1, std::make_pair(0.0, destino));
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), maior);
+            std::pair<double, int> topo = heap.back();
+            heap.pop_back();
+            if (topo.first > distancias[topo.second]) {
+                continue;
+            }
+            // Enlaces simétricos: o vizinho u chega ao destino passando por topo.second
+            for (size_t k = 0; k < grade.vizinhos[topo.second].size(); k++) {
+                int u = grade.vizinhos[topo.second][k];
+                double candidato = topo.first + grade.custos[topo.second][k];
+                if (candidato < distancias[u]) {
+                    distancias[u] = candidato;
+                    saltos[u] = topo.second;
+                    heap.push_back(std::make_pair(candidato, u));
+                    std::push_heap(heap.begin(), heap.end(), maior);
+                }
+            }
+        }
+        for (int v = 0; v < grade.numNos; v++) {
+            tabelas[v].definir(destino, distancias[v], saltos[v]);
+        }
+    }
+}
+
+static void preencherValidador(const GradeSintetica& grade, const std::vector<TabelaRoteamento>& tabelas,
+                               ValidadorRoteamento& validador) {
+    for (int v = 0; v < grade.numNos; v++) {
+        validador.adicionarNo(v, &tabelas[v]);
+        for (size_t k = 0; k < grade.vizinhos[v].size(); k++) {
+            validador.adicionarEnlace(v, grade.vizinhos[v][k], grade.custos[v][k]);
+        }
+    }
+}
+
+// Tabelas ótimas não têm erros; rotas corrompidas de propósito devem ser todas apontadas
+static bool conferirValidador(std::mt19937_64& rng) {
+    GradeSintetica grade;
+    gerarGrade(grade, 12, 0.001, 0.01, CUSTOS_SIMETRICOS, rng);
+    std::vector<TabelaRoteamento> tabelas;
+    calcularTabelas(grade, tabelas);
+    ValidadorRoteamento validador;
+    preencherValidador(grade, tabelas, validador);
+    ValidadorRoteamento::Resultado resultado = validador.validar(0, 4);
+    int64_t pares = (int64_t)grade.numNos * (grade.numNos - 1);
+    if (resultado.rotasVerificadas != pares || resultado.rotasOtimas != pares || resultado.custosDivergentes != 0) {
+        fprintf(stderr, "validador apontou erros em tabelas ótimas\n");
+        return false;
+    }
+
+    // Laço de dois nós: o nó 0 passa a rotear para o último destino via o vizinho 1, que
+    // passa a rotear de volta via o nó 0; e um nó sem rota para o destino 0
+    int destino = grade.numNos - 1;
+    tabelas[0].definir(destino, tabelas[0].custo(destino), 1);
+    tabelas[1].definir(destino, tabelas[1].custo(destino), 0);
+    tabelas[destino].definir(0, TabelaRoteamento::CUSTO_INFINITO, TabelaRoteamento::SEM_ROTA);
+    resultado = validador.validar(0, 4);
+    if (resultado.rotasEmLaco < 2 || resultado.rotasInterrompidas < 1 || resultado.custosDivergentes != 1) {
+        fprintf(stderr, "validador não apontou as rotas corrompidas (laço %lld, interrompidas %lld, divergentes %lld)\n",
+                (long long)resultado.rotasEmLaco, (long long)resultado.rotasInterrompidas,
+                (long long)resultado.custosDivergentes);
+        return false;
+    }
+    return true;
+}
+
+static double medir(const ValidadorRoteamento& validador, unsigned numThreads, int64_t& verificacao) {
+    auto inicio = std::chrono::steady_clock::now();
+    ValidadorRoteamento::Resultado resultado = validador.validar(0, numThreads);
+    verificacao += resultado.rotasOtimas;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+int main(int argc, char **argv) {
+    std::vector<int> lados = {32, 48, 64};
+    if (argc > 1) {
+        lados.clear();
+        for (int i = 1; i < argc; i++) {
+            lados.push_back(atoi(argv[i]));
+        }
+    }
+
+    std::mt19937_64 rng(42);
+    if (!conferirValidador(rng)) {
+        return 1;
+    }
+
+    unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+    int64_t verificacao = 0;
+    double segundosPorDestinoPorEnlace = 0;
+    printf("%8s %12s %12s %14s %9s %14s\n", "nós", "rotas", "1 thread(s)", "ns/rota", "threads", "todas(s)");
+    for (int lado : lados) {
+        GradeSintetica grade;
+        gerarGrade(grade, lado, 0.001, 0.01, CUSTOS_SIMETRICOS, rng);
+        std::vector<TabelaRoteamento> tabelas;
+        calcularTabelas(grade, tabelas);
+        ValidadorRoteamento validador;
+        preencherValidador(grade, tabelas, validador);
+
+        int64_t rotas = (int64_t)grade.numNos * (grade.numNos - 1);
+        double sequencial = medir(validador, 1, verificacao);
+        double paralelo = medir(validador, nucleos, verificacao);
+        printf("%8d %12lld %12.3f %14.1f %9u %14.3f\n", grade.numNos, (long long)rotas, sequencial,
+               sequencial * 1e9 / rotas, nucleos, paralelo);
+
+        int numEnlaces = 4 * lado * (lado - 1);
+        segundosPorDestinoPorEnlace = paralelo / grade.numNos / (numEnlaces * std::log2((double)grade.numNos));
+    }
+
+    // Projeção para uma grade de 100k nós (≈400k enlaces) com os núcleos desta máquina
+    double numNos = 100000, numEnlaces = 4 * numNos;
+    printf("projeção para 100k nós com %u threads: %.0f s\n", nucleos,
+           segundosPorDestinoPorEnlace * numNos * numEnlaces * std::log2(numNos));
+    fprintf(stderr, "verificacao: %lld\n", (long long)verificacao);
+    return 0;
+}
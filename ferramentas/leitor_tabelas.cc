@@ -0,0 +1,124 @@
+// Leitor do arquivo binário colunar de tabelas (parâmetro arquivoTabelasBinario do Roteador).
+// Sem opções, imprime um resumo; também converte para texto no formato do solucionador de
+// referência (para diff) ou para CSV. Independente do OMNeT++; "make leitor_tabelas" (ver makefrag).
+//
+// Uso: leitor_tabelas <arquivo> [-n endereco] [-t] [-c]
+//   -n  tabela de um nó, no formato de imprimirTabelaRoteamento
+//   -t  tabelas de todos os nós, no mesmo formato (compare com a saída do solucionador)
+//   -c  todas as entradas em CSV: no,destino,custo,proximo_salto,instante
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "ArquivoTabelas.h"
+#include "SolucionadorReferencia.h"
+
+static void uso() {
+    fprintf(stderr, "uso: leitor_tabelas <arquivo> [-n endereco] [-t] [-c]\n");
+}
+
+// Monta os vetores densos de um nó e usa a mesma escrita do solucionador de referência
+static void imprimirNo(const LeitorTabelas& leitor, size_t i) {
+    const RegistroNoArquivo& registro = leitor.no(i);
+    if (registro.flags & EscritorTabelas::FLAG_FALHOU) {
+        return;
+    }
+    std::vector<double> custos;
+    std::vector<int> proximosSaltos;
+    for (uint64_t k = registro.primeiraEntrada; k < registro.primeiraEntrada + registro.numEntradas; k++) {
+        size_t destino = leitor.destinos()[k];
+        if (destino >= custos.size()) {
+            custos.resize(destino + 1, INFINITY);
+            proximosSaltos.resize(destino + 1, SolucionadorReferencia::SEM_ROTA);
+        }
+        custos[destino] = leitor.custos()[k];
+        proximosSaltos[destino] = leitor.proximosSaltos()[k];
+    }
+    SolucionadorReferencia::escreverTabela(std::cout, leitor.nome(i), "FINAL", custos, proximosSaltos);
+}
+
+int main(int argc, char **argv) {
+    const char *arquivo = nullptr;
+    int endereco = -1;
+    bool todas = false, csv = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            endereco = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            todas = true;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            csv = true;
+        } else if (argv[i][0] != '-' && arquivo == nullptr) {
+            arquivo = argv[i];
+        } else {
+            uso();
+            return 2;
+        }
+    }
+    if (arquivo == nullptr) {
+        uso();
+        return 2;
+    }
+
+    try {
+        auto inicio = std::chrono::steady_clock::now();
+        LeitorTabelas leitor(arquivo);
+        double tempoAbertura = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        if (endereco >= 0) {
+            long i = leitor.buscarNo(endereco);
+            if (i < 0) {
+                fprintf(stderr, "nó %d não está no arquivo\n", endereco);
+                return 1;
+            }
+            imprimirNo(leitor, i);
+        } else if (todas) {
+            for (size_t i = 0; i < leitor.numNos(); i++) {
+                imprimirNo(leitor, i);
+            }
+        } else if (csv) {
+            printf("no,destino,custo,proximo_salto,instante\n");
+            for (size_t i = 0; i < leitor.numNos(); i++) {
+                const RegistroNoArquivo& registro = leitor.no(i);
+                for (uint64_t k = registro.primeiraEntrada; k < registro.primeiraEntrada + registro.numEntradas; k++) {
+                    printf("%d,%d,%.17g,%d,%.17g\n", registro.endereco, leitor.destinos()[k], leitor.custos()[k],
+                           leitor.proximosSaltos()[k], leitor.instantes()[k]);
+                }
+            }
+        } else {
+            // Resumo; a soma dos custos finitos é a do escalar custo_total_rotas somado entre os nós ativos
+            size_t falhos = 0, inalcancaveis = 0;
+            double somaCustos = 0, ultimaAlteracao = 0;
+            for (size_t i = 0; i < leitor.numNos(); i++) {
+                if (leitor.no(i).flags & EscritorTabelas::FLAG_FALHOU) {
+                    falhos++;
+                }
+            }
+            for (size_t k = 0; k < leitor.numEntradas(); k++) {
+                if (std::isinf(leitor.custos()[k])) {
+                    inalcancaveis++;
+                } else {
+                    somaCustos += leitor.custos()[k];
+                }
+                if (leitor.instantes()[k] > ultimaAlteracao) {
+                    ultimaAlteracao = leitor.instantes()[k];
+                }
+            }
+            printf("nós: %zu (%zu falharam)\n", leitor.numNos(), falhos);
+            printf("entradas: %zu (%zu inalcançáveis)\n", leitor.numEntradas(), inalcancaveis);
+            printf("soma dos custos: %.9g s\n", somaCustos);
+            printf("última alteração de rota: %.9g s\n", ultimaAlteracao);
+            printf("arquivo: %zu bytes, aberto em %.6f s\n", leitor.tamanhoArquivo(), tempoAbertura);
+        }
+    }
+    catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Solucionador de referência por linha de comando: lê a topologia exportada pela simulação
+// (parâmetro arquivoTopologia do Roteador) e imprime as tabelas finais de todos os nós no
+// mesmo formato do Roteador, para comparar com diff o arquivo arquivoTabelas da simulação.
+// Os tempos vão para stderr, como referência de desempenho para o PI. Independente do
+// OMNeT++; "make solucionador" (ver makefrag).
+//
+// Uso: solucionador <topologia> [-t threads] [-o origem] [-a dijkstra|delta] [-d delta] [-s]
+//   -o  resolve só a origem dada e compara o Δ-stepping com o Dijkstra
+//   -s  não imprime as tabelas (só os tempos)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SolucionadorReferencia.h"
+
+// Origens resolvidas por bloco no modo de todos os pares, para não manter N tabelas densas
+static const size_t ORIGENS_POR_BLOCO = 1024;
+
+static void uso() {
+    fprintf(stderr, "uso: solucionador <topologia> [-t threads] [-o origem] [-a dijkstra|delta] [-d delta] [-s]\n");
+}
+
+static double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+static bool mesmosCustos(const RotasReferencia& a, const RotasReferencia& b) {
+    return a.custos == b.custos;
+}
+
+int main(int argc, char **argv) {
+    const char *arquivo = nullptr;
+    unsigned numThreads = 0;
+    int origem = -1;
+    std::string algoritmo = "dijkstra";
+    double delta = 0;
+    bool silencioso = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            numThreads = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            origem = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            algoritmo = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            delta = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0) {
+            silencioso = true;
+        } else if (argv[i][0] != '-' && arquivo == nullptr) {
+            arquivo = argv[i];
+        } else {
+            uso();
+            return 2;
+        }
+    }
+    if (arquivo == nullptr || (algoritmo != "dijkstra" && algoritmo != "delta")) {
+        uso();
+        return 2;
+    }
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    TopologiaReferencia topologia;
+    try {
+        auto inicio = std::chrono::steady_clock::now();
+        topologia = TopologiaReferencia::carregar(arquivo);
+        fprintf(stderr, "topologia: %zu endereços, %zu enlaces, carregada em %.3f s\n", topologia.numEnderecos(),
+                topologia.numEnlaces(), segundosDesde(inicio));
+    }
+    catch (const std::exception& e) {
+        fprintf(stderr, "%s: %s\n", arquivo, e.what());
+        return 1;
+    }
+    SolucionadorReferencia solucionador(topologia);
+
+    if (origem >= 0) {
+        // Uma origem: Δ-stepping paralelo contra o Dijkstra sequencial
+        if ((size_t)origem >= topologia.numEnderecos() || !topologia.ativo(origem)) {
+            fprintf(stderr, "origem %d não é um nó da topologia\n", origem);
+            return 1;
+        }
+        if (delta <= 0) {
+            delta = solucionador.deltaPadrao();
+        }
+        RotasReferencia porDijkstra, porDelta;
+        auto inicio = std::chrono::steady_clock::now();
+        solucionador.dijkstra(origem, porDijkstra);
+        double tempoDijkstra = segundosDesde(inicio);
+        inicio = std::chrono::steady_clock::now();
+        solucionador.deltaStepping(origem, delta, numThreads, porDelta);
+        double tempoDelta = segundosDesde(inicio);
+        fprintf(stderr, "dijkstra: %.6f s; delta-stepping (delta %g, %u threads): %.6f s\n", tempoDijkstra, delta,
+                numThreads, tempoDelta);
+        if (!mesmosCustos(porDijkstra, porDelta)) {
+            fprintf(stderr, "delta-stepping e dijkstra divergem nos custos\n");
+            return 1;
+        }
+        if (!silencioso) {
+            const RotasReferencia& rotas = algoritmo == "delta" ? porDelta : porDijkstra;
+            SolucionadorReferencia::escreverTabela(std::cout, topologia.nomes[origem], "FINAL", rotas.custos,
+                                                   rotas.proximosSaltos);
+        }
+        return 0;
+    }
+
+    // Todos os pares, em blocos de origens resolvidos em paralelo e impressos em ordem de endereço
+    std::vector<int> origens;
+    for (size_t v = 0; v < topologia.numEnderecos(); v++) {
+        if (topologia.ativo(v)) {
+            origens.push_back(v);
+        }
+    }
+    double tempoCalculo = 0;
+    std::vector<int> bloco;
+    std::vector<RotasReferencia> rotas;
+    for (size_t i = 0; i < origens.size(); i += ORIGENS_POR_BLOCO) {
+        bloco.assign(origens.begin() + i, origens.begin() + std::min(origens.size(), i + ORIGENS_POR_BLOCO));
+        auto inicio = std::chrono::steady_clock::now();
+        if (algoritmo == "delta") {
+            // O Δ-stepping já paraleliza cada origem; as origens seguem uma por vez
+            rotas.resize(bloco.size());
+            for (size_t k = 0; k < bloco.size(); k++) {
+                solucionador.deltaStepping(bloco[k], delta, numThreads, rotas[k]);
+            }
+        } else {
+            solucionador.resolverOrigens(bloco, rotas, numThreads);
+        }
+        tempoCalculo += segundosDesde(inicio);
+        if (!silencioso) {
+            for (size_t k = 0; k < bloco.size(); k++) {
+                SolucionadorReferencia::escreverTabela(std::cout, topologia.nomes[bloco[k]], "FINAL", rotas[k].custos,
+                                                       rotas[k].proximosSaltos);
+            }
+        }
+    }
+    double rotasCalculadas = (double)origens.size() * origens.size();
+    fprintf(stderr, "%s de todos os pares: %zu origens, %u threads, %.3f s (%.1f ns/rota)\n", algoritmo.c_str(),
+            origens.size(), numThreads, tempoCalculo, rotasCalculadas > 0 ? tempoCalculo * 1e9 / rotasCalculadas : 0.0);
+    return 0;
+}
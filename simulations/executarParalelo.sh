@@ -0,0 +1,75 @@
+#!/bin/bash
+# Roda a grade de 50k nós sequencialmente (grade50k) e em paralelo (grade50kParalela, uma
+# partição por núcleo, pipes nomeados), mede o tempo de parede das duas execuções e confere
+# se as tabelas finais coincidem (destinos conhecidos e custo total das rotas de cada nó).
+#
+# Uso: simulations/executarParalelo.sh [partições]    (padrão: número de núcleos)
+# O executável pode ser escolhido com EXECUTAVEL=... (padrão: ../PROVA, gerado pelo make)
+#
+# As partições dependem da máquina, então vão para results/particoes.ini (fora do controle de
+# versão), passado às execuções paralelas depois do omnetpp.ini: o arquivo reabre a seção
+# [Config grade50kParalela] e acrescenta o número de partições e o partition-id dos nós.
+
+set -e
+cd "$(dirname "$0")"
+
+PARTICOES=${1:-$(nproc)}
+EXECUTAVEL=${EXECUTAVEL:-../PROVA}
+NUM_NOS=50176
+COLUNAS=224
+
+# Faixas de linhas inteiras da grade: cada fronteira corta apenas COLUNAS enlaces
+LINHAS=$(( NUM_NOS / COLUNAS ))
+LINHAS_POR_PARTICAO=$(( (LINHAS + PARTICOES - 1) / PARTICOES ))
+BLOCO=$(( LINHAS_POR_PARTICAO * COLUNAS ))
+ARQUIVO_PARTICOES=results/particoes.ini
+mkdir -p results
+{
+    echo "# Gerado por executarParalelo.sh: $PARTICOES partições de até $BLOCO nós consecutivos (faixas de linhas da grade)"
+    echo "[Config grade50kParalela]"
+    echo "parsim-num-partitions = $PARTICOES"
+    for ((p = 0; p < PARTICOES; p++)); do
+        inicio=$(( p * BLOCO ))
+        fim=$(( inicio + BLOCO - 1 ))
+        if (( fim >= NUM_NOS )); then
+            fim=$(( NUM_NOS - 1 ))
+        fi
+        if (( inicio <= fim )); then
+            echo "*.no[$inicio..$fim].partition-id = $p"
+        fi
+    done
+} > $ARQUIVO_PARTICOES
+
+rm -f results/grade50k.sca results/grade50kParalela-*.sca
+
+echo "Sequencial..."
+inicio=$(date +%s.%N)
+"$EXECUTAVEL" -u Cmdenv -c grade50k -n .. omnetpp.ini > results/grade50k.log
+tempoSequencial=$(echo "$(date +%s.%N) - $inicio" | bc)
+
+echo "Paralela ($PARTICOES partições)..."
+inicio=$(date +%s.%N)
+for ((p = 1; p < PARTICOES; p++)); do
+    "$EXECUTAVEL" -u Cmdenv -c grade50kParalela -n .. -p$p,$PARTICOES omnetpp.ini $ARQUIVO_PARTICOES > results/grade50kParalela-p$p.log &
+done
+"$EXECUTAVEL" -u Cmdenv -c grade50kParalela -n .. -p0,$PARTICOES omnetpp.ini $ARQUIVO_PARTICOES > results/grade50kParalela-p0.log
+wait
+tempoParalelo=$(echo "$(date +%s.%N) - $inicio" | bc)
+
+echo "Tempo sequencial: ${tempoSequencial}s"
+echo "Tempo paralelo:   ${tempoParalelo}s"
+echo "Speedup:          $(echo "scale=2; $tempoSequencial / $tempoParalelo" | bc)"
+
+# Escalares dos roteadores (módulo, nome, valor); os do gerador dependem da partição
+FILTRO='module =~ "*.no[*]" AND (name =~ destinos_conhecidos OR name =~ custo_total_rotas)'
+opp_scavetool export -f "$FILTRO" -F CSV-R -o results/grade50k.csv results/grade50k.sca
+opp_scavetool export -f "$FILTRO" -F CSV-R -o results/grade50kParalela.csv results/grade50kParalela-*.sca
+extrair() {
+    grep ',scalar,' "$1" | cut -d, -f3,4,7 | sort
+}
+if diff <(extrair results/grade50k.csv) <(extrair results/grade50kParalela.csv) > /dev/null; then
+    echo "Resultados idênticos: $(extrair results/grade50k.csv | wc -l) escalares comparados"
+else
+    echo "ERRO: resultados diferentes entre as execuções sequencial e paralela"
+    exit 1
+fi
@@ -0,0 +1,44 @@
+#!/bin/bash
+# Mede o ganho da arena de mensagens e do pool de retratos de tabela (PoolAlocacao.h) na
+# configuração alocacao: grafo aleatório de 1024 nós com grau médio 16. Compila o projeto em
+# modo release com a contagem de alocações (CONTAR_ALOCACOES=1), com o pool (padrão) e sem ele
+# (POOL=0), e roda cada versão no Cmdenv em modo expresso, imprimindo eventos por segundo e
+# alocações do processo por evento (escalar alocacoes_por_evento do nó inicial).
+#
+# Uso: simulations/medirAlocacao.sh [repetições]    (padrão: 3; vale o menor tempo)
+# Ao final, recompila com as opções padrão do modo release.
+
+set -e
+cd "$(dirname "$0")"
+
+REPETICOES=${1:-3}
+
+for pool in 1 0; do
+    echo "Compilando com POOL=$pool..."
+    make -C .. MODE=release POOL=$pool CONTAR_ALOCACOES=1 > /dev/null
+    cp ../PROVA ../out/PROVA-pool$pool
+done
+
+# Roda REPETICOES vezes e imprime o menor tempo de parede, eventos/s e alocações por evento
+medir() {
+    local descricao=$1 pool=$2
+    local inicio segundos melhor="" eventos alocacoes
+    for ((i = 0; i < REPETICOES; i++)); do
+        inicio=$(date +%s.%N)
+        eventos=$(../out/PROVA-pool$pool -u Cmdenv -c alocacao -n .. --cmdenv-express-mode=true \
+                  --output-scalar-file=results/alocacao-pool$pool.sca omnetpp.ini \
+                  | grep -o 'event #[0-9]*' | tail -1 | tr -dc '0-9')
+        segundos=$(echo "$(date +%s.%N) - $inicio" | bc)
+        if [ -z "$melhor" ] || (( $(echo "$segundos < $melhor" | bc) )); then
+            melhor=$segundos
+        fi
+    done
+    alocacoes=$(awk '$1 == "scalar" && $3 == "alocacoes_por_evento" { print $4 }' results/alocacao-pool$pool.sca)
+    printf "%-12s %10s eventos %8.2f s %12.0f eventos/s %8.2f alocações/evento\n" "$descricao" "$eventos" "$melhor" \
+           "$(echo "$eventos / $melhor" | bc -l)" "$alocacoes"
+}
+
+medir "com pool" 1
+medir "sem pool" 0
+
+make -C .. MODE=release > /dev/null
@@ -0,0 +1,139 @@
+#!/bin/bash
+# Varredura de desempenho: roda a configuração benchEscalabilidade (Cmdenv, modo expresso) para
+# cada topologia gerada, tamanho de rede e semente, e mede de cada execução o tempo de parede,
+# os eventos por segundo e o pico de memória (GNU time), além dos escalares dos roteadores:
+# tempo de convergência (maior entre os nós) e totais de mensagens e bytes enviados.
+#
+# Grava em results/escalabilidade/:
+#   execucoes.csv   uma linha por execução
+#   resumo.csv      média das sementes de cada ponto (topologia, nós)
+# e compara o resumo com a linha de base guardada (escalabilidadeBase.csv): um aumento acima
+# da tolerância em tempo, memória, convergência, mensagens ou bytes, ou uma queda nos eventos
+# por segundo, é uma regressão (código de saída 1). A linha de base depende da máquina e não
+# vem no repositório: grave-a antes com ATUALIZAR_BASE=1; sem ela, o script falha (código 2).
+#
+# Uso: simulations/medirEscalabilidade.sh      (ou "make escalabilidade", que compila antes)
+# Variáveis (padrão entre parênteses):
+#   TOPOLOGIAS      (grade toro aleatoria livreDeEscala anelDeAneis)
+#   TAMANHOS        (1024 2304 4096; "toro" exige quadrados e "anelDeAneis", múltiplos de 8)
+#   SEMENTES        (3: sementes 0 a SEMENTES-1)
+#   TOLERANCIA      (10, em %)
+#   ATUALIZAR_BASE  (vazio; 1 = grava o resumo como nova linha de base, sem comparar)
+#   EXECUTAVEL      (../PROVA, gerado por "make MODE=release")
+
+set -e
+cd "$(dirname "$0")"
+
+EXECUTAVEL=${EXECUTAVEL:-../PROVA}
+TOPOLOGIAS=${TOPOLOGIAS:-grade toro aleatoria livreDeEscala anelDeAneis}
+TAMANHOS=${TAMANHOS:-1024 2304 4096}
+SEMENTES=${SEMENTES:-3}
+TOLERANCIA=${TOLERANCIA:-10}
+BASE=escalabilidadeBase.csv
+DIRETORIO=results/escalabilidade
+EXECUCOES=$DIRETORIO/execucoes.csv
+RESUMO=$DIRETORIO/resumo.csv
+COLUNAS=tempo_parede_s,pico_memoria_kb,eventos,eventos_por_segundo,tempo_convergencia_s,mensagens,mensagens_controle,bytes
+
+if [ ! -x /usr/bin/time ]; then
+    echo "é preciso o GNU time (/usr/bin/time) para medir o pico de memória" >&2
+    exit 1
+fi
+
+mkdir -p $DIRETORIO
+echo "topologia,nos,semente,$COLUNAS" > $EXECUCOES
+
+# Roda um ponto com uma semente e acrescenta a linha em execucoes.csv
+executar() {
+    local topologia=$1 nos=$2 semente=$3
+    local prefixo=$DIRETORIO/$topologia-$nos-$semente
+    local tempo memoria eventos eventosPorSegundo escalares
+    if ! /usr/bin/time -f '%e %M' -o $prefixo.tempo \
+         "$EXECUTAVEL" -u Cmdenv -c benchEscalabilidade -n .. --seed-set=$semente \
+         "--*.tipo=\"$topologia\"" "--*.numNos=$nos" "--*.semente=$semente" \
+         --output-scalar-file=$prefixo.sca omnetpp.ini > $prefixo.log 2>&1; then
+        echo "ERRO: $topologia com $nos nós (semente $semente) falhou; veja $prefixo.log" >&2
+        exit 1
+    fi
+    read -r tempo memoria < <(tail -1 $prefixo.tempo)
+    eventos=$(grep -o 'event #[0-9]*' $prefixo.log | tail -1 | tr -dc '0-9')
+    # Escalares dos roteadores; os do gerador (módulo da rede) ficam de fora
+    escalares=$(awk '$1 == "scalar" && $2 ~ /\.no\[/ {
+                         if ($3 == "tempo_convergencia" && $4 > convergencia) convergencia = $4
+                         else if ($3 == "mensagens_enviadas") mensagens += $4
+                         else if ($3 == "mensagens_controle") controle += $4
+                         else if ($3 == "bytes_enviados") bytes += $4
+                     }
+                     END { printf "%.9g,%.0f,%.0f,%.0f", convergencia, mensagens, controle, bytes }' $prefixo.sca)
+    eventosPorSegundo=$(awk -v e=$eventos -v t=$tempo 'BEGIN { printf "%.0f", (t > 0 ? e / t : 0) }')
+    echo "$topologia,$nos,$semente,$tempo,$memoria,$eventos,$eventosPorSegundo,$escalares" >> $EXECUCOES
+    printf "%-14s %6s nós, semente %s: %8.2f s %10s kB %12s eventos\n" $topologia $nos $semente $tempo $memoria $eventos
+}
+
+for topologia in $TOPOLOGIAS; do
+    for nos in $TAMANHOS; do
+        for ((semente = 0; semente < SEMENTES; semente++)); do
+            executar $topologia $nos $semente
+        done
+    done
+done
+
+# Média das sementes de cada ponto, na ordem da varredura
+awk -F, -v colunas=$COLUNAS '
+    NR == 1 { next }
+    {
+        chave = $1 "," $2
+        if (!(chave in execucoes)) ordem[++pontos] = chave
+        execucoes[chave]++
+        for (i = 4; i <= NF; i++) soma[chave, i] += $i
+        campos = NF
+    }
+    END {
+        print "topologia,nos,execucoes," colunas
+        for (p = 1; p <= pontos; p++) {
+            chave = ordem[p]
+            linha = chave "," execucoes[chave]
+            for (i = 4; i <= campos; i++) linha = linha "," sprintf("%.9g", soma[chave, i] / execucoes[chave])
+            print linha
+        }
+    }' $EXECUCOES > $RESUMO
+echo "Resumo em simulations/$RESUMO"
+
+if [ -n "$ATUALIZAR_BASE" ]; then
+    cp $RESUMO $BASE
+    echo "Linha de base atualizada: simulations/$BASE"
+    exit 0
+fi
+if [ ! -f $BASE ]; then
+    echo "ERRO: sem linha de base (simulations/$BASE) para comparar; grave uma nesta máquina com" >&2
+    echo "      ATUALIZAR_BASE=1 (ex.: make escalabilidade ATUALIZAR_BASE=1) e rode de novo" >&2
+    exit 2
+fi
+
+# Compara cada ponto com a linha de base (mesmas colunas do resumo). Só eventos_por_segundo
+# piora quando cai; a contagem de eventos acompanha as mensagens e não é conferida
+awk -F, -v tolerancia=$TOLERANCIA '
+    FNR == 1 { if (NR == 1) for (i = 1; i <= NF; i++) nome[i] = $i; next }
+    NR == FNR { base[$1 "," $2] = $0; next }
+    {
+        chave = $1 "," $2
+        if (!(chave in base)) {
+            printf "  %s com %s nós: fora da linha de base\n", $1, $2
+            next
+        }
+        split(base[chave], anterior, ",")
+        comparados++
+        for (i = 4; i <= NF; i++) {
+            if (nome[i] == "eventos" || anterior[i] == 0) continue
+            variacao = 100 * ($i - anterior[i]) / anterior[i]
+            piora = nome[i] == "eventos_por_segundo" ? -variacao : variacao
+            if (piora > tolerancia) {
+                printf "  REGRESSÃO %s com %s nós: %s %g -> %g (%+.1f%%)\n", $1, $2, nome[i], anterior[i], $i, variacao
+                regressoes++
+            }
+        }
+    }
+    END {
+        printf "%d pontos comparados com a linha de base: %d regressões (tolerância %s%%)\n", comparados, regressoes, tolerancia
+        exit regressoes > 0
+    }' $BASE $RESUMO
@@ -0,0 +1,42 @@
+#!/bin/bash
+# Mede o custo do log do Roteador em eventos por segundo (configuração registro: grade de 256
+# nós). Compila o projeto duas vezes em modo release, com todo o log (NIVEL_LOG=3) e sem
+# nenhum (NIVEL_LOG=0), e roda o Cmdenv:
+#   - com o log de NIVEL_LOG=3, em modo normal (o log é escrito), para cada valor de nivelLog;
+#   - com o log de NIVEL_LOG=3, em modo expresso (o log é compilado, mas não escrito);
+#   - com NIVEL_LOG=0, em modo expresso (o log não existe no código).
+#
+# Uso: simulations/medirRegistro.sh
+# Ao final, recompila com o nível padrão do modo release.
+
+set -e
+cd "$(dirname "$0")"
+
+for nivel in 3 0; do
+    echo "Compilando com NIVEL_LOG=$nivel..."
+    make -C .. MODE=release NIVEL_LOG=$nivel > /dev/null
+    cp ../PROVA ../out/PROVA-registro$nivel
+done
+
+# Roda uma vez e imprime eventos e eventos por segundo; o log vai para /dev/null
+medir() {
+    local descricao=$1 executavel=$2 run=$3 expresso=$4
+    local inicio fim eventos segundos
+    inicio=$(date +%s.%N)
+    eventos=$("$executavel" -u Cmdenv -c registro -r "$run" -n .. --cmdenv-express-mode="$expresso" omnetpp.ini \
+              | grep -o 'event #[0-9]*' | tail -1 | tr -dc '0-9')
+    fim=$(date +%s.%N)
+    segundos=$(echo "$fim - $inicio" | bc)
+    printf "%-44s %10s eventos %8.2f s %12.0f eventos/s\n" "$descricao" "$eventos" "$segundos" \
+           "$(echo "$eventos / $segundos" | bc -l)"
+}
+
+# Runs da configuração registro: 0 = tabelas, 1 = mensagens, 2 = resumo, 3 = nenhum
+medir "NIVEL_LOG=3, nivelLog=tabelas, normal" ../out/PROVA-registro3 0 false
+medir "NIVEL_LOG=3, nivelLog=mensagens, normal" ../out/PROVA-registro3 1 false
+medir "NIVEL_LOG=3, nivelLog=resumo, normal" ../out/PROVA-registro3 2 false
+medir "NIVEL_LOG=3, nivelLog=nenhum, normal" ../out/PROVA-registro3 3 false
+medir "NIVEL_LOG=3, nivelLog=tabelas, expresso" ../out/PROVA-registro3 0 true
+medir "NIVEL_LOG=0, expresso" ../out/PROVA-registro0 0 true
+
+make -C .. MODE=release > /dev/null
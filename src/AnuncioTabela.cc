@@ -0,0 +1,55 @@
+// Serialização dos anúncios entre partições da simulação paralela
+
+#include "AnuncioTabela.h"
+
+#include <omnetpp.h>
+
+void doParsimPacking(omnetpp::cCommBuffer *b, const AnuncioTabelaPtr& anuncio) {
+    int n = anuncio ? (int)anuncio->tamanho() : -1;
+    b->pack(n);
+    if (n < 0) {
+        return;
+    }
+    if (n > 0) {
+        b->pack(anuncio->destinos.data(), n);
+        b->pack(anuncio->custos.data(), n);
+        b->pack(anuncio->proximosSaltos.data(), n);
+    }
+    int numNosCaminho = anuncio->temCaminhos() ? (int)anuncio->nosCaminho.size() : -1;
+    b->pack(numNosCaminho);
+    if (numNosCaminho >= 0) {
+        b->pack(anuncio->inicioCaminho.data(), n + 1);
+        if (numNosCaminho > 0) {
+            b->pack(anuncio->nosCaminho.data(), numNosCaminho);
+        }
+    }
+}
+
+void doParsimUnpacking(omnetpp::cCommBuffer *b, AnuncioTabelaPtr& anuncio) {
+    int n;
+    b->unpack(n);
+    if (n < 0) {
+        anuncio.reset();
+        return;
+    }
+    std::shared_ptr<AnuncioTabela> recebido = PoolAnuncios::obter();
+    recebido->destinos.resize(n);
+    recebido->custos.resize(n);
+    recebido->proximosSaltos.resize(n);
+    if (n > 0) {
+        b->unpack(recebido->destinos.data(), n);
+        b->unpack(recebido->custos.data(), n);
+        b->unpack(recebido->proximosSaltos.data(), n);
+    }
+    int numNosCaminho;
+    b->unpack(numNosCaminho);
+    if (numNosCaminho >= 0) {
+        recebido->inicioCaminho.resize(n + 1);
+        recebido->nosCaminho.resize(numNosCaminho);
+        b->unpack(recebido->inicioCaminho.data(), n + 1);
+        if (numNosCaminho > 0) {
+            b->unpack(recebido->nosCaminho.data(), numNosCaminho);
+        }
+    }
+    anuncio = recebido;
+}
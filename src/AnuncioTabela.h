@@ -0,0 +1,56 @@
+#ifndef __PROVA_ANUNCIOTABELA_H_
+#define __PROVA_ANUNCIOTABELA_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "PoolAlocacao.h"
+
+namespace omnetpp {
+class cCommBuffer;
+}
+
+// Retrato da tabela de roteamento anunciado em um evento de propagação. É montado uma
+// única vez e compartilhado, por contagem de referências, pelas mensagens de todas as
+// portas; depois de construído não é mais alterado (é obtido do PoolAnuncios, que o
+// reaproveita quando a última mensagem é apagada). O filtro de horizonte dividido de
+// cada porta é aplicado pelo receptor como uma visão sobre este retrato.
+struct AnuncioTabela {
+    std::vector<int> destinos;
+    std::vector<double> custos;
+    std::vector<int> proximosSaltos;  // Próximo salto do remetente para cada destino
+    size_t bytesEntradas = 0;         // Tamanho das entradas na codificação do remetente
+    size_t numInternas = 0;           // Hierarquia: entradas iniciais com rotas internas da área do remetente
+    size_t bytesInternas = 0;         // e a parte delas em bytesEntradas (ambos só no remetente)
+
+    // Vetor de caminho (opcional, vazio se desativado): os nós do caminho da entrada j,
+    // do próximo salto do remetente até o destino, são nosCaminho[inicioCaminho[j]] até
+    // nosCaminho[inicioCaminho[j + 1] - 1]
+    std::vector<int> inicioCaminho;
+    std::vector<int> nosCaminho;
+
+    size_t tamanho() const { return destinos.size(); }
+    bool temCaminhos() const { return !inicioCaminho.empty(); }
+    // O caminho anunciado para a entrada j passa pelo nó?
+    bool caminhoContem(size_t j, int no) const {
+        for (int k = inicioCaminho[j]; k < inicioCaminho[j + 1]; k++) {
+            if (nosCaminho[k] == no) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+typedef std::shared_ptr<const AnuncioTabela> AnuncioTabelaPtr;
+
+inline std::string anuncioParaString(const AnuncioTabelaPtr& anuncio) {
+    return anuncio ? std::to_string(anuncio->tamanho()) + " entradas" : std::string("-");
+}
+
+// Simulação paralela: anúncios que cruzam partições viajam por valor e chegam como um
+// retrato novo (não compartilhado) no receptor (AnuncioTabela.cc)
+void doParsimPacking(omnetpp::cCommBuffer *b, const AnuncioTabelaPtr& anuncio);
+void doParsimUnpacking(omnetpp::cCommBuffer *b, AnuncioTabelaPtr& anuncio);
+
+#endif
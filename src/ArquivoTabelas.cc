@@ -0,0 +1,236 @@
+// Arquivo binário colunar com as tabelas finais: escrita em colunas e leitura por mmap
+
+#include "ArquivoTabelas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char ASSINATURA[8] = {'P', 'I', 'T', 'A', 'B', 'C', 'O', 'L'};
+static const uint32_t VERSAO = 1;
+static const uint32_t MARCA_ORDEM = 0x01020304;
+
+static_assert(sizeof(CabecalhoArquivoTabelas) == 88, "cabeçalho deve ter layout fixo");
+static_assert(sizeof(RegistroNoArquivo) == 32, "registro do índice deve ter layout fixo");
+
+static uint64_t alinhar(uint64_t deslocamento) {
+    return (deslocamento + 7) & ~(uint64_t)7;
+}
+
+void EscritorTabelas::adicionarNo(int endereco, const std::string& nome, uint32_t flags) {
+    if (endereco < 0 || (!indice.empty() && endereco <= indice.back().endereco)) {
+        throw std::invalid_argument("nós devem ser adicionados em ordem crescente de endereço");
+    }
+    RegistroNoArquivo registro;
+    registro.endereco = endereco;
+    registro.flags = flags;
+    registro.primeiraEntrada = destinos.size();
+    registro.numEntradas = 0;
+    registro.deslocamentoNome = nomes.size();
+    indice.push_back(registro);
+    nomes.append(nome);
+    nomes.push_back('\0');
+}
+
+void EscritorTabelas::adicionarEntrada(int destino, double custo, int proximoSalto, double instante) {
+    if (indice.empty()) {
+        throw std::invalid_argument("entrada adicionada antes de qualquer nó");
+    }
+    RegistroNoArquivo& registro = indice.back();
+    if (destino < 0 || (registro.numEntradas > 0 && destino <= destinos.back())) {
+        throw std::invalid_argument("entradas de um nó devem vir em ordem crescente de destino");
+    }
+    destinos.push_back(destino);
+    proximosSaltos.push_back(proximoSalto);
+    custos.push_back(custo);
+    instantes.push_back(instante);
+    registro.numEntradas++;
+}
+
+void EscritorTabelas::escrever(const std::string& arquivo) const {
+    CabecalhoArquivoTabelas cabecalho;
+    std::memset(&cabecalho, 0, sizeof(cabecalho));
+    std::memcpy(cabecalho.assinatura, ASSINATURA, sizeof(ASSINATURA));
+    cabecalho.versao = VERSAO;
+    cabecalho.marcaOrdem = MARCA_ORDEM;
+    cabecalho.numNos = indice.size();
+    cabecalho.numEntradas = destinos.size();
+    cabecalho.deslocamentoIndice = sizeof(cabecalho);
+    cabecalho.deslocamentoDestinos = alinhar(cabecalho.deslocamentoIndice + indice.size() * sizeof(RegistroNoArquivo));
+    cabecalho.deslocamentoProximosSaltos = alinhar(cabecalho.deslocamentoDestinos + destinos.size() * sizeof(int32_t));
+    cabecalho.deslocamentoCustos = alinhar(cabecalho.deslocamentoProximosSaltos + proximosSaltos.size() * sizeof(int32_t));
+    cabecalho.deslocamentoInstantes = alinhar(cabecalho.deslocamentoCustos + custos.size() * sizeof(double));
+    cabecalho.deslocamentoNomes = alinhar(cabecalho.deslocamentoInstantes + instantes.size() * sizeof(double));
+    cabecalho.tamanhoNomes = nomes.size();
+
+    std::ofstream saida(arquivo.c_str(), std::ios::binary | std::ios::trunc);
+    if (!saida) {
+        throw std::runtime_error("não foi possível criar '" + arquivo + "'");
+    }
+    // Cada seção começa no seu deslocamento; o intervalo até ele é preenchido com zeros
+    uint64_t posicao = 0;
+    const char zeros[8] = {};
+    struct Secao {
+        uint64_t deslocamento;
+        const void *dados;
+        size_t bytes;
+    };
+    const Secao secoes[] = {
+        {0, &cabecalho, sizeof(cabecalho)},
+        {cabecalho.deslocamentoIndice, indice.data(), indice.size() * sizeof(RegistroNoArquivo)},
+        {cabecalho.deslocamentoDestinos, destinos.data(), destinos.size() * sizeof(int32_t)},
+        {cabecalho.deslocamentoProximosSaltos, proximosSaltos.data(), proximosSaltos.size() * sizeof(int32_t)},
+        {cabecalho.deslocamentoCustos, custos.data(), custos.size() * sizeof(double)},
+        {cabecalho.deslocamentoInstantes, instantes.data(), instantes.size() * sizeof(double)},
+        {cabecalho.deslocamentoNomes, nomes.data(), nomes.size()},
+    };
+    for (size_t i = 0; i < sizeof(secoes) / sizeof(secoes[0]); i++) {
+        saida.write(zeros, secoes[i].deslocamento - posicao);
+        saida.write((const char *)secoes[i].dados, secoes[i].bytes);
+        posicao = secoes[i].deslocamento + secoes[i].bytes;
+    }
+    if (!saida.flush()) {
+        throw std::runtime_error("erro ao gravar '" + arquivo + "'");
+    }
+}
+
+LeitorTabelas::LeitorTabelas(const std::string& arquivo) {
+#ifndef _WIN32
+    int descritor = open(arquivo.c_str(), O_RDONLY);
+    if (descritor < 0) {
+        throw std::runtime_error("não foi possível abrir '" + arquivo + "'");
+    }
+    struct stat estado;
+    if (fstat(descritor, &estado) != 0) {
+        close(descritor);
+        throw std::runtime_error("não foi possível ler '" + arquivo + "'");
+    }
+    tamanho = estado.st_size;
+    if (tamanho > 0) {
+        void *mapa = mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, descritor, 0);
+        close(descritor);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error("não foi possível mapear '" + arquivo + "'");
+        }
+        dados = (const char *)mapa;
+    } else {
+        close(descritor);
+    }
+#else
+    std::ifstream entrada(arquivo.c_str(), std::ios::binary);
+    if (!entrada) {
+        throw std::runtime_error("não foi possível abrir '" + arquivo + "'");
+    }
+    copia.assign(std::istreambuf_iterator<char>(entrada), std::istreambuf_iterator<char>());
+    dados = copia.data();
+    tamanho = copia.size();
+#endif
+
+    try {
+        if (tamanho < sizeof(CabecalhoArquivoTabelas)) {
+            throw std::runtime_error("arquivo menor que o cabeçalho");
+        }
+        cabecalho = (const CabecalhoArquivoTabelas *)dados;
+        indice = (const RegistroNoArquivo *)(dados + cabecalho->deslocamentoIndice);
+        colunaDestinos = (const int32_t *)(dados + cabecalho->deslocamentoDestinos);
+        colunaProximosSaltos = (const int32_t *)(dados + cabecalho->deslocamentoProximosSaltos);
+        colunaCustos = (const double *)(dados + cabecalho->deslocamentoCustos);
+        colunaInstantes = (const double *)(dados + cabecalho->deslocamentoInstantes);
+        nomes = dados + cabecalho->deslocamentoNomes;
+        validar();
+    }
+    catch (const std::runtime_error& e) {
+#ifndef _WIN32
+        if (dados != nullptr) {
+            munmap((void *)dados, tamanho);
+        }
+#endif
+        throw std::runtime_error("'" + arquivo + "' não é um arquivo de tabelas válido: " + e.what());
+    }
+}
+
+LeitorTabelas::~LeitorTabelas() {
+#ifndef _WIN32
+    if (dados != nullptr) {
+        munmap((void *)dados, tamanho);
+    }
+#endif
+}
+
+void LeitorTabelas::validar() const {
+    if (std::memcmp(cabecalho->assinatura, ASSINATURA, sizeof(ASSINATURA)) != 0) {
+        throw std::runtime_error("assinatura desconhecida");
+    }
+    if (cabecalho->marcaOrdem != MARCA_ORDEM) {
+        throw std::runtime_error("gravado com outra ordem de bytes");
+    }
+    if (cabecalho->versao != VERSAO) {
+        throw std::runtime_error("versão " + std::to_string(cabecalho->versao) + " não suportada");
+    }
+
+    // Cada seção deve estar alinhada e caber no arquivo (contas sem estouro para arquivos corrompidos)
+    uint64_t numNos = cabecalho->numNos, numEntradas = cabecalho->numEntradas;
+    if (numNos > tamanho / sizeof(RegistroNoArquivo) || numEntradas > tamanho / sizeof(int32_t)) {
+        throw std::runtime_error("contagens maiores que o arquivo");
+    }
+    const uint64_t secoes[][2] = {
+        {cabecalho->deslocamentoIndice, numNos * sizeof(RegistroNoArquivo)},
+        {cabecalho->deslocamentoDestinos, numEntradas * sizeof(int32_t)},
+        {cabecalho->deslocamentoProximosSaltos, numEntradas * sizeof(int32_t)},
+        {cabecalho->deslocamentoCustos, numEntradas * sizeof(double)},
+        {cabecalho->deslocamentoInstantes, numEntradas * sizeof(double)},
+        {cabecalho->deslocamentoNomes, cabecalho->tamanhoNomes},
+    };
+    for (size_t i = 0; i < sizeof(secoes) / sizeof(secoes[0]); i++) {
+        if (secoes[i][0] % 8 != 0 || secoes[i][0] > tamanho || secoes[i][1] > tamanho - secoes[i][0]) {
+            throw std::runtime_error("seção fora do arquivo");
+        }
+    }
+    if (cabecalho->tamanhoNomes > 0 && nomes[cabecalho->tamanhoNomes - 1] != '\0') {
+        throw std::runtime_error("seção de nomes sem terminador");
+    }
+
+    for (uint64_t i = 0; i < numNos; i++) {
+        const RegistroNoArquivo& registro = indice[i];
+        if (i > 0 && registro.endereco <= indice[i - 1].endereco) {
+            throw std::runtime_error("índice fora de ordem de endereço");
+        }
+        if (registro.primeiraEntrada > numEntradas || registro.numEntradas > numEntradas - registro.primeiraEntrada
+            || registro.deslocamentoNome >= cabecalho->tamanhoNomes) {
+            throw std::runtime_error("registro do nó " + std::to_string(registro.endereco) + " fora das seções");
+        }
+    }
+}
+
+long LeitorTabelas::buscarNo(int endereco) const {
+    size_t inicio = 0, fim = numNos();
+    while (inicio < fim) {
+        size_t meio = inicio + (fim - inicio) / 2;
+        if (indice[meio].endereco < endereco) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return (inicio < numNos() && indice[inicio].endereco == endereco) ? (long)inicio : -1;
+}
+
+long LeitorTabelas::buscarRota(int endereco, int destino) const {
+    long posicao = buscarNo(endereco);
+    if (posicao < 0) {
+        return -1;
+    }
+    const int32_t *inicio = colunaDestinos + indice[posicao].primeiraEntrada;
+    const int32_t *fim = inicio + indice[posicao].numEntradas;
+    const int32_t *encontrado = std::lower_bound(inicio, fim, destino);
+    return (encontrado != fim && *encontrado == destino) ? (long)(encontrado - colunaDestinos) : -1;
+}
@@ -0,0 +1,112 @@
+#ifndef __PROVA_ARQUIVOTABELAS_H_
+#define __PROVA_ARQUIVOTABELAS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arquivo binário colunar com as tabelas finais de todos os nós, para análise sem passar
+// pelos logs de texto. Não depende do OMNeT++: a simulação escreve (parâmetro
+// arquivoTabelasBinario do Roteador) e a ferramenta leitor_tabelas, ou qualquer script que
+// mapeie o arquivo na memória, lê.
+//
+// Layout (ordem de bytes da máquina, conferida por marcaOrdem; seções alinhadas em 8 bytes):
+//   CabecalhoArquivoTabelas
+//   indice:          RegistroNoArquivo[numNos], em ordem crescente de endereço
+//   destinos:        int32[numEntradas]
+//   proximosSaltos:  int32[numEntradas]
+//   custos:          double[numEntradas]
+//   instantes:       double[numEntradas]
+//   nomes:           nomes dos nós terminados em '\0'
+// Nas quatro colunas, as entradas de cada nó são contíguas (primeiraEntrada e numEntradas
+// no índice) e estão em ordem crescente de destino.
+// Custos infinitos marcam destinos que ficaram inalcançáveis num cenário dinâmico; o
+// instante é o da última alteração da rota, em segundos de simulação.
+
+struct CabecalhoArquivoTabelas {
+    char assinatura[8];                 // "PITABCOL"
+    uint32_t versao;
+    uint32_t marcaOrdem;                // 0x01020304 escrito na ordem de bytes de quem gravou
+    uint64_t numNos;
+    uint64_t numEntradas;
+    uint64_t deslocamentoIndice;        // Deslocamentos em bytes a partir do início do arquivo
+    uint64_t deslocamentoDestinos;
+    uint64_t deslocamentoProximosSaltos;
+    uint64_t deslocamentoCustos;
+    uint64_t deslocamentoInstantes;
+    uint64_t deslocamentoNomes;
+    uint64_t tamanhoNomes;
+};
+
+struct RegistroNoArquivo {
+    int32_t endereco;
+    uint32_t flags;                     // FLAG_FALHOU: nó parado por um evento de falha (sem entradas)
+    uint64_t primeiraEntrada;
+    uint64_t numEntradas;
+    uint64_t deslocamentoNome;          // Posição do nome dentro da seção de nomes
+};
+
+// Acumula as tabelas em colunas e grava o arquivo de uma vez
+class EscritorTabelas {
+  public:
+    static constexpr uint32_t FLAG_FALHOU = 1;
+
+    // Os nós devem vir em ordem crescente de endereço, e as entradas de cada nó em ordem
+    // crescente de destino (lança std::invalid_argument)
+    void adicionarNo(int endereco, const std::string& nome, uint32_t flags = 0);
+    void adicionarEntrada(int destino, double custo, int proximoSalto, double instante);
+
+    // Lança std::runtime_error se não conseguir gravar
+    void escrever(const std::string& arquivo) const;
+
+  private:
+    std::vector<RegistroNoArquivo> indice;
+    std::vector<int32_t> destinos;
+    std::vector<int32_t> proximosSaltos;
+    std::vector<double> custos;
+    std::vector<double> instantes;
+    std::string nomes;
+};
+
+// Mapeia o arquivo na memória (POSIX) ou o lê inteiro (Windows) e expõe as colunas sem cópia
+class LeitorTabelas {
+  public:
+    // Lança std::runtime_error se o arquivo não existir ou não for um arquivo de tabelas válido
+    explicit LeitorTabelas(const std::string& arquivo);
+    ~LeitorTabelas();
+    LeitorTabelas(const LeitorTabelas&) = delete;
+    LeitorTabelas& operator=(const LeitorTabelas&) = delete;
+
+    size_t numNos() const { return cabecalho->numNos; }
+    size_t numEntradas() const { return cabecalho->numEntradas; }
+    size_t tamanhoArquivo() const { return tamanho; }
+
+    const RegistroNoArquivo& no(size_t i) const { return indice[i]; }
+    const char *nome(size_t i) const { return nomes + indice[i].deslocamentoNome; }
+    const int32_t *destinos() const { return colunaDestinos; }
+    const int32_t *proximosSaltos() const { return colunaProximosSaltos; }
+    const double *custos() const { return colunaCustos; }
+    const double *instantes() const { return colunaInstantes; }
+
+    // Posição do nó no índice, ou -1 (busca binária)
+    long buscarNo(int endereco) const;
+    // Posição da entrada (endereco -> destino) nas colunas, ou -1
+    long buscarRota(int endereco, int destino) const;
+
+  private:
+    void validar() const;
+
+    const char *dados = nullptr;
+    size_t tamanho = 0;
+    std::vector<char> copia;            // Conteúdo lido quando não há mmap
+    const CabecalhoArquivoTabelas *cabecalho = nullptr;
+    const RegistroNoArquivo *indice = nullptr;
+    const int32_t *colunaDestinos = nullptr;
+    const int32_t *colunaProximosSaltos = nullptr;
+    const double *colunaCustos = nullptr;
+    const double *colunaInstantes = nullptr;
+    const char *nomes = nullptr;
+};
+
+#endif
@@ -0,0 +1,301 @@
+// Árvore de caminhos mínimos com atualização incremental (SPF incremental)
+
+#include "ArvoreCaminhos.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+void ArvoreCaminhos::reiniciar(int raiz) {
+    raizArvore = raiz;
+    saidas.clear();
+    entradas.clear();
+    distancias.clear();
+    pais.clear();
+    saltos.clear();
+    invalidado.clear();
+    nosTocados.clear();
+    contadores = Estatisticas();
+    garantir(raiz);
+    distancias[raiz] = 0;
+    pais[raiz] = raiz;
+    saltos[raiz] = raiz;
+}
+
+void ArvoreCaminhos::garantir(int no) {
+    if ((size_t)no < distancias.size()) {
+        return;
+    }
+    size_t tamanho = no + 1;
+    saidas.resize(tamanho);
+    entradas.resize(tamanho);
+    distancias.resize(tamanho, CUSTO_INFINITO);
+    pais.resize(tamanho, -1);
+    saltos.resize(tamanho, TabelaRoteamento::SEM_ROTA);
+    invalidado.resize(tamanho, 0);
+}
+
+void ArvoreCaminhos::trocarEnlaces(int no, const int *vizinhos, const double *custos, size_t n) {
+    std::vector<Aresta>& enlaces = saidas[no];
+    enlaces.resize(n);
+    for (size_t j = 0; j < n; j++) {
+        enlaces[j].no = vizinhos[j];
+        enlaces[j].custo = custos[j];
+    }
+}
+
+void ArvoreCaminhos::removerEntrada(int no, int origem) {
+    std::vector<Aresta>& lista = entradas[no];
+    for (size_t k = 0; k < lista.size(); k++) {
+        if (lista[k].no == origem) {
+            lista[k] = lista.back();
+            lista.pop_back();
+            return;
+        }
+    }
+}
+
+void ArvoreCaminhos::definirEntrada(int no, int origem, double custo) {
+    std::vector<Aresta>& lista = entradas[no];
+    for (size_t k = 0; k < lista.size(); k++) {
+        if (lista[k].no == origem) {
+            lista[k].custo = custo;
+            return;
+        }
+    }
+    Aresta aresta;
+    aresta.no = origem;
+    aresta.custo = custo;
+    lista.push_back(aresta);
+}
+
+void ArvoreCaminhos::enfileirar(double distancia, int no) {
+    fila.push_back(ItemFila(distancia, no));
+    std::push_heap(fila.begin(), fila.end(), std::greater<ItemFila>());
+}
+
+void ArvoreCaminhos::substituir(int no, const int *vizinhos, const double *custos, size_t n) {
+    garantir(no);
+    if (n > 0) {
+        garantir(vizinhos[n - 1]);
+    }
+    const std::vector<Aresta>& antigas = saidas[no];
+    for (size_t i = 0; i < antigas.size(); i++) {
+        removerEntrada(antigas[i].no, no);
+    }
+    for (size_t j = 0; j < n; j++) {
+        definirEntrada(vizinhos[j], no, custos[j]);
+    }
+    trocarEnlaces(no, vizinhos, custos, n);
+}
+
+void ArvoreCaminhos::atualizar(int u, const int *vizinhos, const double *custos, size_t n) {
+    contadores.atualizacoes++;
+    garantir(u);
+    if (n > 0) {
+        garantir(vizinhos[n - 1]);
+    }
+
+    // Compara os enlaces antigos e novos de u (ambos em ordem crescente de destino): os que
+    // pioram um enlace de árvore são raízes de subárvores invalidadas; os que podem
+    // melhorar um destino são guardados pelo índice na lista nova
+    const std::vector<Aresta>& antigas = saidas[u];
+    pilha.clear();
+    melhorados.clear();
+    size_t i = 0, j = 0;
+    while (i < antigas.size() || j < n) {
+        if (j == n || (i < antigas.size() && antigas[i].no < vizinhos[j])) {
+            int v = antigas[i].no;
+            removerEntrada(v, u);
+            if (pais[v] == u) {
+                pilha.push_back(v);
+            }
+            i++;
+        } else if (i == antigas.size() || vizinhos[j] < antigas[i].no) {
+            definirEntrada(vizinhos[j], u, custos[j]);
+            melhorados.push_back(j);
+            j++;
+        } else {
+            int v = vizinhos[j];
+            if (custos[j] != antigas[i].custo) {
+                definirEntrada(v, u, custos[j]);
+                if (custos[j] < antigas[i].custo) {
+                    melhorados.push_back(j);
+                } else if (pais[v] == u) {
+                    pilha.push_back(v);
+                }
+            }
+            i++;
+            j++;
+        }
+    }
+    trocarEnlaces(u, vizinhos, custos, n);
+
+    // Subárvores invalidadas: os filhos de cada nó são os destinos dos seus enlaces de
+    // saída que o têm como pai (u nunca está nelas, pois é ancestral das raízes)
+    invalidados.clear();
+    for (size_t k = 0; k < pilha.size(); k++) {
+        invalidado[pilha[k]] = 1;
+        invalidados.push_back(pilha[k]);
+    }
+    while (!pilha.empty()) {
+        int x = pilha.back();
+        pilha.pop_back();
+        const std::vector<Aresta>& filhos = saidas[x];
+        for (size_t k = 0; k < filhos.size(); k++) {
+            int w = filhos[k].no;
+            if (!invalidado[w] && pais[w] == x) {
+                invalidado[w] = 1;
+                invalidados.push_back(w);
+                pilha.push_back(w);
+            }
+        }
+    }
+    contadores.nosInvalidados += invalidados.size();
+    for (size_t k = 0; k < invalidados.size(); k++) {
+        int x = invalidados[k];
+        distancias[x] = CUSTO_INFINITO;
+        pais[x] = -1;
+        saltos[x] = TabelaRoteamento::SEM_ROTA;
+        nosTocados.push_back(x);
+    }
+
+    // Cada nó invalidado parte da melhor oferta dos vizinhos de entrada que continuam na árvore
+    fila.clear();
+    for (size_t k = 0; k < invalidados.size(); k++) {
+        int x = invalidados[k];
+        const std::vector<Aresta>& ofertas = entradas[x];
+        for (size_t m = 0; m < ofertas.size(); m++) {
+            int y = ofertas[m].no;
+            if (!invalidado[y] && distancias[y] < CUSTO_INFINITO) {
+                double distancia = distancias[y] + ofertas[m].custo;
+                if (distancia < distancias[x]) {
+                    distancias[x] = distancia;
+                    pais[x] = y;
+                }
+            }
+        }
+        if (distancias[x] < CUSTO_INFINITO) {
+            enfileirar(distancias[x], x);
+        }
+    }
+    for (size_t k = 0; k < invalidados.size(); k++) {
+        invalidado[invalidados[k]] = 0;
+    }
+
+    // Enlaces novos ou mais baratos de u
+    if (distancias[u] < CUSTO_INFINITO) {
+        const std::vector<Aresta>& novas = saidas[u];
+        for (size_t k = 0; k < melhorados.size(); k++) {
+            const Aresta& aresta = novas[melhorados[k]];
+            double distancia = distancias[u] + aresta.custo;
+            if (distancia < distancias[aresta.no]) {
+                distancias[aresta.no] = distancia;
+                pais[aresta.no] = u;
+                enfileirar(distancia, aresta.no);
+            }
+        }
+    }
+
+    propagar();
+}
+
+void ArvoreCaminhos::recalcular() {
+    contadores.recalculos++;
+    std::fill(distancias.begin(), distancias.end(), CUSTO_INFINITO);
+    std::fill(pais.begin(), pais.end(), -1);
+    std::fill(saltos.begin(), saltos.end(), TabelaRoteamento::SEM_ROTA);
+    distancias[raizArvore] = 0;
+    pais[raizArvore] = raizArvore;
+    fila.clear();
+    enfileirar(0, raizArvore);
+    propagar();
+
+    nosTocados.clear();
+    for (size_t no = 0; no < distancias.size(); no++) {
+        nosTocados.push_back(no);
+    }
+}
+
+// Dijkstra a partir da fila: fixa cada nó retirado (o pai já foi fixado antes, então o
+// próximo salto é herdado dele) e relaxa os seus enlaces de saída
+void ArvoreCaminhos::propagar() {
+    while (!fila.empty()) {
+        std::pop_heap(fila.begin(), fila.end(), std::greater<ItemFila>());
+        ItemFila item = fila.back();
+        fila.pop_back();
+        int x = item.second;
+        if (item.first > distancias[x]) {
+            continue;
+        }
+        contadores.nosProcessados++;
+        saltos[x] = (pais[x] == raizArvore) ? x : saltos[pais[x]];
+        nosTocados.push_back(x);
+
+        const std::vector<Aresta>& enlaces = saidas[x];
+        for (size_t k = 0; k < enlaces.size(); k++) {
+            double distancia = item.first + enlaces[k].custo;
+            int w = enlaces[k].no;
+            if (distancia < distancias[w]) {
+                distancias[w] = distancia;
+                pais[w] = x;
+                enfileirar(distancia, w);
+            }
+        }
+    }
+}
+
+static bool custosIguais(double a, double b) {
+    if (a == b) {
+        return true;
+    }
+    return std::fabs(a - b) <= 1e-9 * std::max(std::fabs(a), std::fabs(b));
+}
+
+bool ArvoreCaminhos::conferir(int& divergente) const {
+    size_t numNos = distancias.size();
+    std::vector<double> referencia(numNos, CUSTO_INFINITO);
+    std::priority_queue<ItemFila, std::vector<ItemFila>, std::greater<ItemFila>> heap;
+    referencia[raizArvore] = 0;
+    heap.push(ItemFila(0.0, raizArvore));
+    while (!heap.empty()) {
+        ItemFila item = heap.top();
+        heap.pop();
+        if (item.first > referencia[item.second]) {
+            continue;
+        }
+        const std::vector<Aresta>& enlaces = saidas[item.second];
+        for (size_t k = 0; k < enlaces.size(); k++) {
+            double distancia = item.first + enlaces[k].custo;
+            if (distancia < referencia[enlaces[k].no]) {
+                referencia[enlaces[k].no] = distancia;
+                heap.push(ItemFila(distancia, enlaces[k].no));
+            }
+        }
+    }
+
+    for (size_t no = 0; no < numNos; no++) {
+        divergente = no;
+        if (!custosIguais(distancias[no], referencia[no])) {
+            return false;
+        }
+        if ((int)no == raizArvore || distancias[no] == CUSTO_INFINITO) {
+            continue;
+        }
+        // O pai tem um enlace até o nó com o custo da diferença, e o próximo salto é o dele
+        int pai = pais[no];
+        if (pai < 0 || saltos[no] != (pai == raizArvore ? (int)no : saltos[pai])) {
+            return false;
+        }
+        const std::vector<Aresta>& enlaces = saidas[pai];
+        size_t k = 0;
+        while (k < enlaces.size() && enlaces[k].no != (int)no) {
+            k++;
+        }
+        if (k == enlaces.size() || !custosIguais(distancias[pai] + enlaces[k].custo, distancias[no])) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,101 @@
+#ifndef __PROVA_ARVORECAMINHOS_H_
+#define __PROVA_ARVORECAMINHOS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TabelaRoteamento.h"
+
+// Árvore de caminhos mínimos a partir de uma raiz, mantida de forma incremental (no estilo
+// de Ramalingam-Reps e do SPF incremental dos roteadores de estado de enlace). Não depende
+// do OMNeT++: o grafo é dado pelos enlaces de saída de cada nó, substituídos de uma vez
+// (um LSA por nó).
+//
+// Ao substituir os enlaces de um nó u, só a parte afetada da árvore é refeita:
+// - enlaces de u que sumiram ou ficaram mais caros e eram o enlace de árvore de v
+//   invalidam a subárvore de v. Esses nós perdem a distância e recebem a melhor oferta dos
+//   vizinhos de entrada não afetados;
+// - enlaces novos ou mais baratos que melhoram v o colocam na fila;
+// - um Dijkstra a partir da fila propaga só as distâncias que melhoram.
+// Os nós fora da subárvore invalidada e que não melhoram não são visitados. O custo é
+// proporcional aos nós alterados e aos seus enlaces, não ao tamanho da rede.
+//
+// Custos não negativos. Em empates, a árvore mantém o pai que já tinha, então o próximo
+// salto pode diferir do de um cálculo completo com a mesma distância.
+class ArvoreCaminhos {
+  public:
+    static constexpr double CUSTO_INFINITO = TabelaRoteamento::CUSTO_INFINITO;
+
+    struct Estatisticas {
+        uint64_t atualizacoes = 0;      // Chamadas de atualizar()
+        uint64_t recalculos = 0;        // Chamadas de recalcular()
+        uint64_t nosInvalidados = 0;    // Nós das subárvores invalidadas
+        uint64_t nosProcessados = 0;    // Nós retirados da fila (fixados) pelo Dijkstra
+    };
+
+    // Árvore vazia (só a raiz, sem enlaces)
+    void reiniciar(int raiz);
+
+    // Substitui os enlaces de saída de 'no' (vizinhos em ordem crescente, sem repetição)
+    // e corrige a árvore só onde ela muda
+    void atualizar(int no, const int *vizinhos, const double *custos, size_t n);
+    // Só substitui os enlaces: a árvore fica desatualizada até recalcular()
+    void substituir(int no, const int *vizinhos, const double *custos, size_t n);
+    // Dijkstra completo a partir da raiz
+    void recalcular();
+
+    // Confere a árvore com um Dijkstra completo nos mesmos enlaces: distâncias iguais (a
+    // menos do arredondamento) e o próximo salto de cada nó igual ao do seu pai na árvore.
+    // Em caso de divergência, retorna false com o primeiro nó divergente
+    bool conferir(int& divergente) const;
+
+    int raiz() const { return raizArvore; }
+    // Maior nó conhecido + 1
+    size_t capacidade() const { return distancias.size(); }
+    double distancia(int no) const {
+        return (no >= 0 && (size_t)no < distancias.size()) ? distancias[no] : CUSTO_INFINITO;
+    }
+    // Primeiro nó do caminho a partir da raiz (a própria raiz para ela mesma)
+    int primeiroSalto(int no) const {
+        return (no >= 0 && (size_t)no < saltos.size()) ? saltos[no] : TabelaRoteamento::SEM_ROTA;
+    }
+
+    // Nós cuja distância ou próximo salto pode ter mudado desde limparTocados() (pode ter
+    // repetições; depois de recalcular(), todos os nós)
+    const std::vector<int>& tocados() const { return nosTocados; }
+    void limparTocados() { nosTocados.clear(); }
+
+    const Estatisticas& estatisticas() const { return contadores; }
+
+  private:
+    struct Aresta {
+        int no;        // Destino (nos enlaces de saída) ou origem (nos de entrada)
+        double custo;
+    };
+    typedef std::pair<double, int> ItemFila;
+
+    void garantir(int no);
+    void trocarEnlaces(int no, const int *vizinhos, const double *custos, size_t n);
+    void removerEntrada(int no, int origem);
+    void definirEntrada(int no, int origem, double custo);
+    void enfileirar(double distancia, int no);
+    void propagar();
+
+    int raizArvore = 0;
+    std::vector<std::vector<Aresta>> saidas;     // Enlaces de saída de cada nó, por destino crescente
+    std::vector<std::vector<Aresta>> entradas;   // Enlaces de entrada de cada nó (em qualquer ordem)
+    std::vector<double> distancias;
+    std::vector<int> pais;                       // Pai na árvore (-1 = inalcançável; a raiz é pai de si)
+    std::vector<int> saltos;
+
+    // Áreas de trabalho, reaproveitadas entre atualizações
+    std::vector<ItemFila> fila;                  // Heap mínimo
+    std::vector<unsigned char> invalidado;
+    std::vector<int> invalidados;
+    std::vector<int> pilha;
+    std::vector<int> melhorados;                 // Destinos de enlaces de u novos ou mais baratos
+    std::vector<int> nosTocados;
+    Estatisticas contadores;
+};
+
+#endif
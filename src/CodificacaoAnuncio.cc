@@ -0,0 +1,121 @@
+// Tamanho das mensagens do PI na rede (formatos nativo e compacto)
+
+#include "CodificacaoAnuncio.h"
+
+#include <cmath>
+
+// Bytes fixos do formato nativo
+static const size_t BYTES_INT = 4;
+static const size_t BYTES_DOUBLE = 8;
+static const size_t BYTES_FLAGS = 1;   // Tipo da mensagem e flags (completa, destinos implícitos)
+
+void CodificacaoAnuncio::configurar(Formato novoFormato, double novaResolucao, bool implicitos) {
+    formato = novoFormato;
+    resolucaoCusto = novaResolucao;
+    destinosImplicitos = implicitos;
+}
+
+double CodificacaoAnuncio::quantizar(double custo) const {
+    if (formato != FORMATO_COMPACTO || resolucaoCusto <= 0 || !std::isfinite(custo)) {
+        return custo;
+    }
+    return std::llround(custo / resolucaoCusto) * resolucaoCusto;
+}
+
+size_t CodificacaoAnuncio::bytesVarint(uint64_t valor) {
+    // 7 bits de carga por byte (LEB128)
+    size_t bytes = 1;
+    while (valor >= 0x80) {
+        valor >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+size_t CodificacaoAnuncio::bytesCabecalho(int idNoOrigem, int numeroSequencia, size_t numEntradas) const {
+    if (formato == FORMATO_NATIVO) {
+        return 3 * BYTES_INT + BYTES_FLAGS;
+    }
+    return BYTES_FLAGS + bytesVarint(idNoOrigem) + bytesVarint(numeroSequencia) + bytesVarint(numEntradas);
+}
+
+size_t CodificacaoAnuncio::bytesControle(int idNoOrigem) const {
+    // Origem e instante da última alteração (simtime de 64 bits)
+    if (formato == FORMATO_NATIVO) {
+        return BYTES_INT + BYTES_FLAGS + BYTES_DOUBLE;
+    }
+    return BYTES_FLAGS + bytesVarint(idNoOrigem) + BYTES_DOUBLE;
+}
+
+size_t CodificacaoAnuncio::bytesEntradas(const AnuncioTabela& anuncio, std::vector<unsigned>& bytesPorEntrada) const {
+    size_t n = anuncio.tamanho();
+    bytesPorEntrada.assign(n, 0);
+    if (n == 0) {
+        return 0;
+    }
+
+    // Vetor de caminho: número de nós seguido dos nós, por entrada
+    size_t totalCaminhos = 0;
+    if (anuncio.temCaminhos()) {
+        for (size_t i = 0; i < n; i++) {
+            size_t inicio = anuncio.inicioCaminho[i];
+            size_t fim = anuncio.inicioCaminho[i + 1];
+            if (formato == FORMATO_NATIVO) {
+                bytesPorEntrada[i] = BYTES_INT * (1 + fim - inicio);
+            } else {
+                bytesPorEntrada[i] = bytesVarint(fim - inicio);
+                for (size_t k = inicio; k < fim; k++) {
+                    bytesPorEntrada[i] += bytesVarint(anuncio.nosCaminho[k]);
+                }
+            }
+            totalCaminhos += bytesPorEntrada[i];
+        }
+    }
+
+    if (formato == FORMATO_NATIVO) {
+        for (size_t i = 0; i < n; i++) {
+            bytesPorEntrada[i] += BYTES_INT + BYTES_DOUBLE;
+        }
+        return totalCaminhos + n * (BYTES_INT + BYTES_DOUBLE);
+    }
+
+    size_t total = totalCaminhos;
+    for (size_t i = 0; i < n; i++) {
+        double custo = anuncio.custos[i];
+        size_t bytesCusto;
+        if (resolucaoCusto <= 0) {
+            bytesCusto = BYTES_DOUBLE;
+        } else if (!std::isfinite(custo)) {
+            bytesCusto = 1;
+        } else {
+            bytesCusto = bytesVarint(std::llround(custo / resolucaoCusto) + 1);
+        }
+        bytesPorEntrada[i] += bytesCusto;
+        total += bytesCusto;
+    }
+
+    // Destinos por diferença: o primeiro absoluto, os demais como distância - 1
+    size_t bytesDiferencas = bytesVarint(anuncio.destinos[0]);
+    for (size_t i = 1; i < n; i++) {
+        bytesDiferencas += bytesVarint(anuncio.destinos[i] - anuncio.destinos[i - 1] - 1);
+    }
+
+    if (destinosImplicitos) {
+        size_t intervalo = (size_t)(anuncio.destinos[n - 1] - anuncio.destinos[0]) + 1;
+        size_t bytesIntervalo = bytesVarint(anuncio.destinos[0]);
+        if (intervalo == n) {
+            // Tabela densa: os destinos são o intervalo a partir do primeiro
+            return total + bytesIntervalo;
+        }
+        size_t bytesBitmap = bytesIntervalo + (intervalo + 7) / 8;
+        if (bytesBitmap < bytesDiferencas) {
+            return total + bytesBitmap;
+        }
+    }
+
+    bytesPorEntrada[0] += bytesVarint(anuncio.destinos[0]);
+    for (size_t i = 1; i < n; i++) {
+        bytesPorEntrada[i] += bytesVarint(anuncio.destinos[i] - anuncio.destinos[i - 1] - 1);
+    }
+    return total + bytesDiferencas;
+}
@@ -0,0 +1,49 @@
+#ifndef __PROVA_CODIFICACAOANUNCIO_H_
+#define __PROVA_CODIFICACAOANUNCIO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AnuncioTabela.h"
+
+// Formato das mensagens na rede. Não serializa nada: calcula quantos bytes cada mensagem
+// ocuparia, para que setByteLength() modele o custo de banda em canais com taxa, e
+// quantiza os custos como o receptor os veria.
+//
+// Nativo: int de 32 bits por destino e double por custo.
+// Compacto: destinos em ordem crescente codificados como varint da diferença para o
+// anterior; custos em ponto fixo com 'resolucaoCusto' (varint de custo/resolução + 1,
+// com 0 reservado para custo infinito). Com 'destinosImplicitos', um intervalo contíguo
+// de destinos leva apenas o primeiro, e um intervalo esparso pode ir como bitmap.
+// Com vetor de caminho, cada entrada leva ainda o número de nós e os nós do caminho
+// (int de 32 bits no nativo, varint no compacto).
+class CodificacaoAnuncio {
+  public:
+    enum Formato {
+        FORMATO_NATIVO,
+        FORMATO_COMPACTO
+    };
+
+    void configurar(Formato formato, double resolucaoCusto, bool destinosImplicitos);
+    Formato getFormato() const { return formato; }
+
+    // Custo como chega ao receptor (arredondado à resolução no formato compacto)
+    double quantizar(double custo) const;
+
+    // Cabeçalho de um anúncio: origem, sequência, flags e número de entradas
+    size_t bytesCabecalho(int idNoOrigem, int numeroSequencia, size_t numEntradas) const;
+    // Mensagem de controle (confirmação ou aviso de convergência)
+    size_t bytesControle(int idNoOrigem) const;
+    // Corpo de um anúncio com destinos em ordem crescente. 'bytesPorEntrada' recebe a
+    // parcela de cada entrada; o restante do total é fixo (início do intervalo, bitmap)
+    size_t bytesEntradas(const AnuncioTabela& anuncio, std::vector<unsigned>& bytesPorEntrada) const;
+
+    static size_t bytesVarint(uint64_t valor);
+
+  private:
+    Formato formato = FORMATO_NATIVO;
+    double resolucaoCusto = 0;
+    bool destinosImplicitos = false;
+};
+
+#endif
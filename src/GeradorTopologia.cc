@@ -0,0 +1,423 @@
+// Gerador de topologias parametrizadas para estudos de escalabilidade do PI
+// (grade/toro, Erdős–Rényi, Barabási–Albert, fat-tree k-ária e anel de anéis),
+// compatível com simulação paralela particionada
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "GeradorTopologia.h"
+#include "ParticaoAreas.h"
+
+Define_Module(GeradorTopologia);
+
+void GeradorTopologia::doBuildInside() {
+    // Submódulos e conexões declarados em NED (redes derivadas podem acrescentar os seus)
+    cModule::doBuildInside();
+
+    numNos = par("numNos").intValue();
+    numAreas = 0;
+    enlacesEntreParticoes = 0;
+    menorAtrasoEntreParticoes = 0;
+    rng.seed(par("semente").intValue());
+    std::string tipo = par("tipo").stdstringValue();
+
+    if (tipo == "grade") {
+        gerarGrade(false);
+    } else if (tipo == "toro") {
+        gerarGrade(true);
+    } else if (tipo == "aleatoria") {
+        gerarAleatoria();
+    } else if (tipo == "livreDeEscala") {
+        gerarLivreDeEscala();
+    } else if (tipo == "fatTree") {
+        gerarFatTree();
+    } else if (tipo == "anelDeAneis") {
+        gerarAnelDeAneis();
+    } else {
+        throw cRuntimeError("tipo de topologia inválido: '%s' (use \"grade\", \"toro\", \"aleatoria\", "
+                            "\"livreDeEscala\", \"fatTree\" ou \"anelDeAneis\")", tipo.c_str());
+    }
+
+    EV << "Gerador criou topologia '" << tipo << "' com " << numNos << " nós e "
+       << arestas.size() << " enlaces" << endl;
+
+    construirRede();
+}
+
+void GeradorTopologia::finish() {
+    recordScalar("nos", numNos);
+    recordScalar("enlaces", arestas.size());
+    recordScalar("enlaces_entre_particoes", enlacesEntreParticoes);
+    if (numAreas > 0) {
+        recordScalar("areas", numAreas);
+    }
+    if (enlacesEntreParticoes > 0) {
+        recordScalar("lookahead", menorAtrasoEntreParticoes);
+    }
+}
+
+void GeradorTopologia::gerarGrade(bool toro) {
+    int numColunas = par("colunas").intValue();
+    if (numColunas <= 0) {
+        numColunas = (int)std::ceil(std::sqrt((double)numNos));
+    }
+    int numLinhas = (numNos + numColunas - 1) / numColunas;
+
+    if (toro) {
+        // As arestas de retorno só fecham ciclos próprios em um retângulo completo
+        if (numNos % numColunas != 0 || numLinhas < 3 || numColunas < 3) {
+            throw cRuntimeError("toro exige numNos múltiplo de colunas e ao menos 3x3 nós "
+                                "(numNos=%d, colunas=%d)", numNos, numColunas);
+        }
+    }
+
+    for (int i = 0; i < numNos; i++) {
+        int linha = i / numColunas;
+        int coluna = i % numColunas;
+        if (coluna + 1 < numColunas && i + 1 < numNos) {
+            arestas.push_back(Aresta(i, i + 1));
+        } else if (toro) {
+            arestas.push_back(Aresta(i, linha * numColunas));
+        }
+        if (i + numColunas < numNos) {
+            arestas.push_back(Aresta(i, i + numColunas));
+        } else if (toro) {
+            arestas.push_back(Aresta(i, coluna));
+        }
+    }
+}
+
+void GeradorTopologia::gerarAleatoria() {
+    // G(n,p) com p = grauMedio / (n - 1), sorteando apenas os saltos entre arestas
+    // (Batagelj e Brandes): O(n + m) em vez de testar os n^2 pares
+    if (numNos < 2) {
+        throw cRuntimeError("topologia aleatória exige ao menos 2 nós");
+    }
+    double p = par("grauMedio").doubleValue() / (numNos - 1);
+    if (p <= 0) {
+        throw cRuntimeError("grauMedio deve ser positivo");
+    }
+
+    if (p >= 1) {
+        for (int v = 1; v < numNos; v++) {
+            for (int w = 0; w < v; w++) {
+                arestas.push_back(Aresta(v, w));
+            }
+        }
+    } else {
+        double logComplemento = std::log(1 - p);
+        long v = 1, w = -1;
+        while (v < numNos) {
+            w += 1 + (long)std::floor(std::log(1 - sortearUniforme(0, 1)) / logComplemento);
+            while (w >= v && v < numNos) {
+                w -= v;
+                v++;
+            }
+            if (v < numNos) {
+                arestas.push_back(Aresta((int)v, (int)w));
+            }
+        }
+    }
+
+    if (par("garantirConexa").boolValue()) {
+        conectarComponentes();
+    }
+}
+
+void GeradorTopologia::conectarComponentes() {
+    // Union-find das componentes; cada componente nova é ligada à anterior por um enlace
+    std::vector<int> pai(numNos);
+    std::iota(pai.begin(), pai.end(), 0);
+    auto raiz = [&pai](int no) {
+        while (pai[no] != no) {
+            pai[no] = pai[pai[no]];
+            no = pai[no];
+        }
+        return no;
+    };
+    for (size_t i = 0; i < arestas.size(); i++) {
+        pai[raiz(arestas[i].first)] = raiz(arestas[i].second);
+    }
+
+    int anterior = -1;
+    int enlacesAdicionados = 0;
+    for (int no = 0; no < numNos; no++) {
+        if (raiz(no) != no) {
+            continue;
+        }
+        if (anterior != -1) {
+            arestas.push_back(Aresta(anterior, no));
+            enlacesAdicionados++;
+        }
+        anterior = no;
+    }
+    if (enlacesAdicionados > 0) {
+        EV << "Gerador ligou " << enlacesAdicionados + 1 << " componentes desconexas" << endl;
+    }
+}
+
+void GeradorTopologia::gerarLivreDeEscala() {
+    // Barabási-Albert: começa com um clique de m+1 nós; cada nó novo se liga a m nós
+    // distintos escolhidos com probabilidade proporcional ao grau
+    int m = par("arestasPorNo").intValue();
+    if (m < 1 || numNos <= m) {
+        throw cRuntimeError("livreDeEscala exige 1 <= arestasPorNo < numNos (arestasPorNo=%d, numNos=%d)", m, numNos);
+    }
+
+    // Cada extremidade de aresta aparece uma vez: sortear deste vetor é sortear pelo grau
+    std::vector<int> extremidades;
+    extremidades.reserve(2 * (size_t)m * numNos);
+    for (int v = 0; v <= m; v++) {
+        for (int w = 0; w < v; w++) {
+            arestas.push_back(Aresta(v, w));
+            extremidades.push_back(v);
+            extremidades.push_back(w);
+        }
+    }
+
+    std::vector<int> escolhidos;
+    for (int v = m + 1; v < numNos; v++) {
+        escolhidos.clear();
+        while ((int)escolhidos.size() < m) {
+            int alvo = extremidades[sortearInteiro(extremidades.size())];
+            if (std::find(escolhidos.begin(), escolhidos.end(), alvo) == escolhidos.end()) {
+                escolhidos.push_back(alvo);
+            }
+        }
+        for (size_t i = 0; i < escolhidos.size(); i++) {
+            arestas.push_back(Aresta(v, escolhidos[i]));
+            extremidades.push_back(v);
+            extremidades.push_back(escolhidos[i]);
+        }
+    }
+}
+
+void GeradorTopologia::gerarFatTree() {
+    // Numeração: núcleo, depois por pod (agregação e borda), depois hosts por switch de borda
+    int k = par("aridade").intValue();
+    if (k < 2 || k % 2 != 0) {
+        throw cRuntimeError("fatTree exige aridade par >= 2 (aridade=%d)", k);
+    }
+    int metade = k / 2;
+    int numNucleo = metade * metade;
+    int primeiroPod = numNucleo;
+    int primeiroHost = numNucleo + k * k;
+    numNos = primeiroHost + k * k * k / 4;
+
+    for (int pod = 0; pod < k; pod++) {
+        int agregacao = primeiroPod + pod * k;
+        int borda = agregacao + metade;
+        for (int a = 0; a < metade; a++) {
+            // Agregação 'a' de cada pod liga-se aos núcleos a*k/2 .. a*k/2 + k/2 - 1
+            for (int c = 0; c < metade; c++) {
+                arestas.push_back(Aresta(agregacao + a, a * metade + c));
+            }
+            for (int b = 0; b < metade; b++) {
+                arestas.push_back(Aresta(agregacao + a, borda + b));
+            }
+        }
+        for (int b = 0; b < metade; b++) {
+            int primeiroHostBorda = primeiroHost + (pod * metade + b) * metade;
+            for (int h = 0; h < metade; h++) {
+                arestas.push_back(Aresta(borda + b, primeiroHostBorda + h));
+            }
+        }
+    }
+}
+
+void GeradorTopologia::gerarAnelDeAneis() {
+    // Anéis de 'tamanhoAnel' nós; o primeiro nó de cada anel forma o anel externo
+    int tamanhoAnel = par("tamanhoAnel").intValue();
+    if (tamanhoAnel < 3 || numNos % tamanhoAnel != 0) {
+        throw cRuntimeError("anelDeAneis exige tamanhoAnel >= 3 e numNos múltiplo de tamanhoAnel "
+                            "(numNos=%d, tamanhoAnel=%d)", numNos, tamanhoAnel);
+    }
+    int numAneis = numNos / tamanhoAnel;
+
+    for (int anel = 0; anel < numAneis; anel++) {
+        int primeiro = anel * tamanhoAnel;
+        for (int i = 0; i < tamanhoAnel; i++) {
+            arestas.push_back(Aresta(primeiro + i, primeiro + (i + 1) % tamanhoAnel));
+        }
+    }
+    // Com dois anéis o anel externo é um único enlace
+    if (numAneis == 2) {
+        arestas.push_back(Aresta(0, tamanhoAnel));
+    } else if (numAneis > 2) {
+        for (int anel = 0; anel < numAneis; anel++) {
+            arestas.push_back(Aresta(anel * tamanhoAnel, ((anel + 1) % numAneis) * tamanhoAnel));
+        }
+    }
+}
+
+void GeradorTopologia::construirRede() {
+    cModuleType *tipoNo = cModuleType::get(par("tipoNo").stringValue());
+
+    // Hierarquia: o endereço de cada nó identifica a sua área (endereco / tamanhoArea)
+    int tamanhoArea = par("tamanhoArea").intValue();
+    std::vector<int> enderecos;
+    if (tamanhoArea < 0) {
+        throw cRuntimeError("tamanhoArea não pode ser negativo");
+    } else if (tamanhoArea > 0) {
+        numAreas = ParticaoAreas::numerar(numNos, arestas, tamanhoArea, enderecos);
+        EV << "Gerador agrupou os " << numNos << " nós em " << numAreas << " áreas de até "
+           << tamanhoArea << " nós" << endl;
+    }
+
+    // Graus conhecidos de antemão: cada vetor de portas é dimensionado uma única vez
+    std::vector<int> grau(numNos, 0);
+    for (size_t i = 0; i < arestas.size(); i++) {
+        grau[arestas[i].first]++;
+        grau[arestas[i].second]++;
+    }
+
+    // Em simulação paralela, create() devolve um placeholder para nós de outra partição
+    addSubmoduleVector("no", numNos);
+    std::vector<cModule *> nos(numNos);
+    for (int i = 0; i < numNos; i++) {
+        nos[i] = tipoNo->create("no", this, i);
+        if (tamanhoArea > 0) {
+            // Os vizinhos resolvem o endereço pelo parâmetro, que os placeholders não têm
+            if (nos[i]->isPlaceholder()) {
+                throw cRuntimeError("tamanhoArea não é suportado em simulação paralela");
+            }
+            nos[i]->par("endereco").setIntValue(enderecos[i]);
+            if (nos[i]->hasPar("tamanhoArea")) {
+                nos[i]->par("tamanhoArea").setIntValue(tamanhoArea);
+            }
+        }
+        nos[i]->finalizeParameters();
+        nos[i]->setGateSize("portas", grau[i]);
+    }
+
+    configurarAtrasos();
+    double taxa = par("taxaEnlace").doubleValue();
+
+    std::vector<int> proximaPorta(numNos, 0);
+    for (size_t i = 0; i < arestas.size(); i++) {
+        int a = arestas[i].first;
+        int b = arestas[i].second;
+        int portaA = proximaPorta[a]++;
+        int portaB = proximaPorta[b]++;
+
+        // Sorteado para todo enlace, local ou não, para que a sequência seja a mesma em
+        // todas as partições. O roteador usa o atraso do canal de saída como custo
+        double atraso = sortearAtraso();
+
+        bool localA = !nos[a]->isPlaceholder();
+        bool localB = !nos[b]->isPlaceholder();
+        if (!localA && !localB) {
+            continue;
+        }
+        if (localA != localB) {
+            // O atraso dos enlaces cortados é o lookahead do protocolo de sincronização
+            if (enlacesEntreParticoes == 0 || atraso < menorAtrasoEntreParticoes) {
+                menorAtrasoEntreParticoes = atraso;
+            }
+            enlacesEntreParticoes++;
+        }
+
+        // O canal fica na partição que envia; a ponta remota só precisa do proxy
+        cGate *saidaA = nos[a]->gate("portas$o", portaA);
+        cGate *saidaB = nos[b]->gate("portas$o", portaB);
+        cGate *entradaA = nos[a]->gate("portas$i", portaA);
+        cGate *entradaB = nos[b]->gate("portas$i", portaB);
+        if (localA) {
+            cDatarateChannel *ida = cDatarateChannel::create("canal");
+            ida->setDelay(atraso);
+            ida->setDatarate(taxa);
+            saidaA->connectTo(entradaB, ida);
+        } else {
+            saidaA->connectTo(entradaB);
+        }
+        if (localB) {
+            cDatarateChannel *volta = cDatarateChannel::create("canal");
+            volta->setDelay(atraso);
+            volta->setDatarate(taxa);
+            saidaB->connectTo(entradaA, volta);
+        } else {
+            saidaB->connectTo(entradaA);
+        }
+    }
+
+    if (enlacesEntreParticoes > 0) {
+        EV << "Gerador: " << enlacesEntreParticoes << " enlaces entre partições, lookahead de "
+           << menorAtrasoEntreParticoes << "s" << endl;
+    }
+
+    // A inicialização dos nós fica a cargo do kernel, depois de toda a rede construída
+    for (int i = 0; i < numNos; i++) {
+        nos[i]->buildInside();
+    }
+}
+
+void GeradorTopologia::configurarAtrasos() {
+    std::string distribuicao = par("distribuicaoAtraso").stdstringValue();
+    atrasoMinimo = par("atrasoMinimo").doubleValue();
+    atrasoMaximo = par("atrasoMaximo").doubleValue();
+    atrasoMedio = par("atrasoMedio").doubleValue();
+    desvioAtraso = par("desvioAtraso").doubleValue();
+
+    if (distribuicao == "constante") {
+        distribuicaoAtraso = ATRASO_CONSTANTE;
+        if (atrasoMedio <= 0) {
+            throw cRuntimeError("atraso constante inválido: exige atrasoMedio > 0");
+        }
+        return;
+    }
+    if (distribuicao == "uniforme") {
+        distribuicaoAtraso = ATRASO_UNIFORME;
+    } else if (distribuicao == "exponencial") {
+        distribuicaoAtraso = ATRASO_EXPONENCIAL;
+    } else if (distribuicao == "normalTruncada") {
+        distribuicaoAtraso = ATRASO_NORMAL_TRUNCADA;
+    } else {
+        throw cRuntimeError("distribuicaoAtraso desconhecida: \"%s\"", distribuicao.c_str());
+    }
+    if (atrasoMinimo <= 0 || atrasoMaximo < atrasoMinimo) {
+        throw cRuntimeError("atrasos de enlace inválidos: exige 0 < atrasoMinimo <= atrasoMaximo");
+    }
+    if (distribuicaoAtraso != ATRASO_UNIFORME && (atrasoMedio <= atrasoMinimo || atrasoMedio >= atrasoMaximo)) {
+        throw cRuntimeError("atrasoMedio inválido para \"%s\": exige atrasoMinimo < atrasoMedio < atrasoMaximo",
+                            distribuicao.c_str());
+    }
+    if (distribuicaoAtraso == ATRASO_NORMAL_TRUNCADA && desvioAtraso <= 0) {
+        throw cRuntimeError("desvioAtraso inválido: exige desvioAtraso > 0");
+    }
+}
+
+// Sorteia do rng de 'semente', como o grafo: o número de sorteios de cada enlace (inclusive
+// os ressorteios do truncamento) só depende dos parâmetros, e não da partição
+double GeradorTopologia::sortearAtraso() {
+    // Limite de ressorteios: com a média dentro da faixa, cada sorteio cai nela com
+    // probabilidade razoável, salvo um desvio muito maior que a faixa
+    const int maximoSorteios = 1000;
+    switch (distribuicaoAtraso) {
+        case ATRASO_UNIFORME:
+            return sortearUniforme(atrasoMinimo, atrasoMaximo);
+        case ATRASO_CONSTANTE:
+            return atrasoMedio;
+        case ATRASO_EXPONENCIAL: {
+            std::exponential_distribution<double> excesso(1 / (atrasoMedio - atrasoMinimo));
+            for (int i = 0; i < maximoSorteios; i++) {
+                double atraso = atrasoMinimo + excesso(rng);
+                if (atraso <= atrasoMaximo) {
+                    return atraso;
+                }
+            }
+            break;
+        }
+        case ATRASO_NORMAL_TRUNCADA: {
+            std::normal_distribution<double> normal(atrasoMedio, desvioAtraso);
+            for (int i = 0; i < maximoSorteios; i++) {
+                double atraso = normal(rng);
+                if (atraso >= atrasoMinimo && atraso <= atrasoMaximo) {
+                    return atraso;
+                }
+            }
+            break;
+        }
+    }
+    throw cRuntimeError("nenhum atraso em [atrasoMinimo, atrasoMaximo] em %d sorteios: aumente a faixa ou "
+                        "reduza desvioAtraso", maximoSorteios);
+}
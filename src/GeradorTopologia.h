@@ -0,0 +1,61 @@
+#ifndef __PROVA_GERADORTOPOLOGIA_H_
+#define __PROVA_GERADORTOPOLOGIA_H_
+
+#include <omnetpp.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace omnetpp;
+
+// Rede que cria os nós e enlaces de uma topologia parametrizada na sua própria construção
+// (doBuildInside), antes da inicialização. Cada enlace vira um par de cDatarateChannel com
+// o mesmo atraso. Em simulação paralela, os nós de outras partições são placeholders e só
+// os enlaces com ao menos uma ponta local são conectados.
+class GeradorTopologia : public cModule {
+  private:
+    typedef std::pair<int, int> Aresta;
+
+    enum DistribuicaoAtraso {
+        ATRASO_UNIFORME,
+        ATRASO_EXPONENCIAL,
+        ATRASO_NORMAL_TRUNCADA,
+        ATRASO_CONSTANTE
+    };
+
+    int numNos;
+    std::vector<Aresta> arestas;
+    std::mt19937 rng;                  // Independente da partição (ver GeradorTopologia.ned)
+    int numAreas;                      // Áreas numeradas (0 = sem hierarquia)
+    int enlacesEntreParticoes;
+    double menorAtrasoEntreParticoes;  // Lookahead disponível ao protocolo de sincronização
+    DistribuicaoAtraso distribuicaoAtraso;
+    double atrasoMinimo;
+    double atrasoMaximo;
+    double atrasoMedio;
+    double desvioAtraso;
+
+  protected:
+    virtual void doBuildInside() override;
+    virtual void finish() override;
+
+    double sortearUniforme(double a, double b) { return std::uniform_real_distribution<double>(a, b)(rng); }
+    int sortearInteiro(int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); }
+
+    // Lê e valida distribuicaoAtraso e os seus parâmetros; sortearAtraso() sorteia o de um enlace
+    void configurarAtrasos();
+    double sortearAtraso();
+
+    // Geradores de arestas (preenchem 'arestas' e ajustam numNos quando a topologia o define)
+    void gerarGrade(bool toro);
+    void gerarAleatoria();
+    void gerarLivreDeEscala();
+    void gerarFatTree();
+    void gerarAnelDeAneis();
+    void conectarComponentes();
+
+    // Instancia os nós, dimensiona as portas e conecta os enlaces
+    void construirRede();
+};
+
+#endif
@@ -150,6 +150,8 @@ void doParsimUnpacking(omnetpp::cCommBuffer *, T& t)
 
 }  // namespace omnetpp
 
+Register_Enum(TipoMensagem, (TipoMensagem::MSG_PROPAGACAO, TipoMensagem::MSG_CONFIRMACAO, TipoMensagem::MSG_CONVERGENCIA, TipoMensagem::MSG_SONDAGEM, TipoMensagem::MSG_ECO, TipoMensagem::MSG_ESTADO_ENLACE, TipoMensagem::MSG_DADOS));
+
 Register_Class(Mensagem)
 
 Mensagem::Mensagem(const char *name, short kind) : ::omnetpp::cPacket(name, kind)
@@ -163,8 +165,6 @@ Mensagem::Mensagem(const Mensagem& other) : ::omnetpp::cPacket(other)
 
 Mensagem::~Mensagem()
 {
-    delete [] this->destinos;
-    delete [] this->custos;
 }
 
 Mensagem& Mensagem::operator=(const Mensagem& other)
@@ -178,50 +178,45 @@ Mensagem& Mensagem::operator=(const Mensagem& other)
 void Mensagem::copy(const Mensagem& other)
 {
     this->idNoOrigem = other.idNoOrigem;
-    delete [] this->destinos;
-    this->destinos = (other.destinos_arraysize==0) ? nullptr : new int[other.destinos_arraysize];
-    destinos_arraysize = other.destinos_arraysize;
-    for (size_t i = 0; i < destinos_arraysize; i++) {
-        this->destinos[i] = other.destinos[i];
-    }
-    delete [] this->custos;
-    this->custos = (other.custos_arraysize==0) ? nullptr : new double[other.custos_arraysize];
-    custos_arraysize = other.custos_arraysize;
-    for (size_t i = 0; i < custos_arraysize; i++) {
-        this->custos[i] = other.custos[i];
-    }
+    this->numeroSequencia = other.numeroSequencia;
+    this->completa = other.completa;
+    this->ultimaAlteracao = other.ultimaAlteracao;
+    this->anuncio = other.anuncio;
+    this->vizinhoExcluido = other.vizinhoExcluido;
+    this->epoca = other.epoca;
+    this->anunciosEpoca = other.anunciosEpoca;
+    this->destino = other.destino;
+    this->saltos = other.saltos;
 }
 
 void Mensagem::parsimPack(omnetpp::cCommBuffer *b) const
 {
     ::omnetpp::cPacket::parsimPack(b);
     doParsimPacking(b,this->idNoOrigem);
-    b->pack(destinos_arraysize);
-    doParsimArrayPacking(b,this->destinos,destinos_arraysize);
-    b->pack(custos_arraysize);
-    doParsimArrayPacking(b,this->custos,custos_arraysize);
+    doParsimPacking(b,this->numeroSequencia);
+    doParsimPacking(b,this->completa);
+    doParsimPacking(b,this->ultimaAlteracao);
+    doParsimPacking(b,this->anuncio);
+    doParsimPacking(b,this->vizinhoExcluido);
+    doParsimPacking(b,this->epoca);
+    doParsimPacking(b,this->anunciosEpoca);
+    doParsimPacking(b,this->destino);
+    doParsimPacking(b,this->saltos);
 }
 
 void Mensagem::parsimUnpack(omnetpp::cCommBuffer *b)
 {
     ::omnetpp::cPacket::parsimUnpack(b);
     doParsimUnpacking(b,this->idNoOrigem);
-    delete [] this->destinos;
-    b->unpack(destinos_arraysize);
-    if (destinos_arraysize == 0) {
-        this->destinos = nullptr;
-    } else {
-        this->destinos = new int[destinos_arraysize];
-        doParsimArrayUnpacking(b,this->destinos,destinos_arraysize);
-    }
-    delete [] this->custos;
-    b->unpack(custos_arraysize);
-    if (custos_arraysize == 0) {
-        this->custos = nullptr;
-    } else {
-        this->custos = new double[custos_arraysize];
-        doParsimArrayUnpacking(b,this->custos,custos_arraysize);
-    }
+    doParsimUnpacking(b,this->numeroSequencia);
+    doParsimUnpacking(b,this->completa);
+    doParsimUnpacking(b,this->ultimaAlteracao);
+    doParsimUnpacking(b,this->anuncio);
+    doParsimUnpacking(b,this->vizinhoExcluido);
+    doParsimUnpacking(b,this->epoca);
+    doParsimUnpacking(b,this->anunciosEpoca);
+    doParsimUnpacking(b,this->destino);
+    doParsimUnpacking(b,this->saltos);
 }
 
 int Mensagem::getIdNoOrigem() const
@@ -234,136 +229,94 @@ void Mensagem::setIdNoOrigem(int idNoOrigem)
     this->idNoOrigem = idNoOrigem;
 }
 
-size_t Mensagem::getDestinosArraySize() const
+int Mensagem::getNumeroSequencia() const
+{
+    return this->numeroSequencia;
+}
+
+void Mensagem::setNumeroSequencia(int numeroSequencia)
+{
+    this->numeroSequencia = numeroSequencia;
+}
+
+bool Mensagem::getCompleta() const
+{
+    return this->completa;
+}
+
+void Mensagem::setCompleta(bool completa)
+{
+    this->completa = completa;
+}
+
+omnetpp::simtime_t Mensagem::getUltimaAlteracao() const
 {
-    return destinos_arraysize;
+    return this->ultimaAlteracao;
 }
 
-int Mensagem::getDestinos(size_t k) const
+void Mensagem::setUltimaAlteracao(omnetpp::simtime_t ultimaAlteracao)
 {
-    if (k >= destinos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)destinos_arraysize, (unsigned long)k);
-    return this->destinos[k];
+    this->ultimaAlteracao = ultimaAlteracao;
 }
 
-void Mensagem::setDestinosArraySize(size_t newSize)
+const AnuncioTabelaPtr& Mensagem::getAnuncio() const
 {
-    int *destinos2 = (newSize==0) ? nullptr : new int[newSize];
-    size_t minSize = destinos_arraysize < newSize ? destinos_arraysize : newSize;
-    for (size_t i = 0; i < minSize; i++)
-        destinos2[i] = this->destinos[i];
-    for (size_t i = minSize; i < newSize; i++)
-        destinos2[i] = 0;
-    delete [] this->destinos;
-    this->destinos = destinos2;
-    destinos_arraysize = newSize;
+    return this->anuncio;
 }
 
-void Mensagem::setDestinos(size_t k, int destinos)
+void Mensagem::setAnuncio(const AnuncioTabelaPtr& anuncio)
 {
-    if (k >= destinos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)destinos_arraysize, (unsigned long)k);
-    this->destinos[k] = destinos;
+    this->anuncio = anuncio;
 }
 
-void Mensagem::insertDestinos(size_t k, int destinos)
+int Mensagem::getVizinhoExcluido() const
 {
-    if (k > destinos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)destinos_arraysize, (unsigned long)k);
-    size_t newSize = destinos_arraysize + 1;
-    int *destinos2 = new int[newSize];
-    size_t i;
-    for (i = 0; i < k; i++)
-        destinos2[i] = this->destinos[i];
-    destinos2[k] = destinos;
-    for (i = k + 1; i < newSize; i++)
-        destinos2[i] = this->destinos[i-1];
-    delete [] this->destinos;
-    this->destinos = destinos2;
-    destinos_arraysize = newSize;
+    return this->vizinhoExcluido;
 }
 
-void Mensagem::appendDestinos(int destinos)
+void Mensagem::setVizinhoExcluido(int vizinhoExcluido)
 {
-    insertDestinos(destinos_arraysize, destinos);
+    this->vizinhoExcluido = vizinhoExcluido;
 }
 
-void Mensagem::eraseDestinos(size_t k)
+int Mensagem::getEpoca() const
 {
-    if (k >= destinos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)destinos_arraysize, (unsigned long)k);
-    size_t newSize = destinos_arraysize - 1;
-    int *destinos2 = (newSize == 0) ? nullptr : new int[newSize];
-    size_t i;
-    for (i = 0; i < k; i++)
-        destinos2[i] = this->destinos[i];
-    for (i = k; i < newSize; i++)
-        destinos2[i] = this->destinos[i+1];
-    delete [] this->destinos;
-    this->destinos = destinos2;
-    destinos_arraysize = newSize;
+    return this->epoca;
 }
 
-size_t Mensagem::getCustosArraySize() const
+void Mensagem::setEpoca(int epoca)
 {
-    return custos_arraysize;
+    this->epoca = epoca;
 }
 
-double Mensagem::getCustos(size_t k) const
+int Mensagem::getAnunciosEpoca() const
 {
-    if (k >= custos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)custos_arraysize, (unsigned long)k);
-    return this->custos[k];
+    return this->anunciosEpoca;
 }
 
-void Mensagem::setCustosArraySize(size_t newSize)
+void Mensagem::setAnunciosEpoca(int anunciosEpoca)
 {
-    double *custos2 = (newSize==0) ? nullptr : new double[newSize];
-    size_t minSize = custos_arraysize < newSize ? custos_arraysize : newSize;
-    for (size_t i = 0; i < minSize; i++)
-        custos2[i] = this->custos[i];
-    for (size_t i = minSize; i < newSize; i++)
-        custos2[i] = 0;
-    delete [] this->custos;
-    this->custos = custos2;
-    custos_arraysize = newSize;
+    this->anunciosEpoca = anunciosEpoca;
 }
 
-void Mensagem::setCustos(size_t k, double custos)
+int Mensagem::getDestino() const
 {
-    if (k >= custos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)custos_arraysize, (unsigned long)k);
-    this->custos[k] = custos;
+    return this->destino;
 }
 
-void Mensagem::insertCustos(size_t k, double custos)
+void Mensagem::setDestino(int destino)
 {
-    if (k > custos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)custos_arraysize, (unsigned long)k);
-    size_t newSize = custos_arraysize + 1;
-    double *custos2 = new double[newSize];
-    size_t i;
-    for (i = 0; i < k; i++)
-        custos2[i] = this->custos[i];
-    custos2[k] = custos;
-    for (i = k + 1; i < newSize; i++)
-        custos2[i] = this->custos[i-1];
-    delete [] this->custos;
-    this->custos = custos2;
-    custos_arraysize = newSize;
+    this->destino = destino;
 }
 
-void Mensagem::appendCustos(double custos)
+int Mensagem::getSaltos() const
 {
-    insertCustos(custos_arraysize, custos);
+    return this->saltos;
 }
 
-void Mensagem::eraseCustos(size_t k)
+void Mensagem::setSaltos(int saltos)
 {
-    if (k >= custos_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)custos_arraysize, (unsigned long)k);
-    size_t newSize = custos_arraysize - 1;
-    double *custos2 = (newSize == 0) ? nullptr : new double[newSize];
-    size_t i;
-    for (i = 0; i < k; i++)
-        custos2[i] = this->custos[i];
-    for (i = k; i < newSize; i++)
-        custos2[i] = this->custos[i+1];
-    delete [] this->custos;
-    this->custos = custos2;
-    custos_arraysize = newSize;
+    this->saltos = saltos;
 }
 
 class MensagemDescriptor : public omnetpp::cClassDescriptor
@@ -372,8 +325,15 @@ class MensagemDescriptor : public omnetpp::cClassDescriptor
     mutable const char **propertyNames;
     enum FieldConstants {
         FIELD_idNoOrigem,
-        FIELD_destinos,
-        FIELD_custos,
+        FIELD_numeroSequencia,
+        FIELD_completa,
+        FIELD_ultimaAlteracao,
+        FIELD_anuncio,
+        FIELD_vizinhoExcluido,
+        FIELD_epoca,
+        FIELD_anunciosEpoca,
+        FIELD_destino,
+        FIELD_saltos,
     };
   public:
     MensagemDescriptor();
@@ -440,7 +400,7 @@ const char *MensagemDescriptor::getProperty(const char *propertyName) const
 int MensagemDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
-    return base ? 3+base->getFieldCount() : 3;
+    return base ? 10+base->getFieldCount() : 10;
 }
 
 unsigned int MensagemDescriptor::getFieldTypeFlags(int field) const
@@ -453,10 +413,17 @@ unsigned int MensagemDescriptor::getFieldTypeFlags(int field) const
     }
     static unsigned int fieldTypeFlags[] = {
         FD_ISEDITABLE,    // FIELD_idNoOrigem
-        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_destinos
-        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_custos
+        FD_ISEDITABLE,    // FIELD_numeroSequencia
+        FD_ISEDITABLE,    // FIELD_completa
+        FD_ISEDITABLE,    // FIELD_ultimaAlteracao
+        0,    // FIELD_anuncio
+        FD_ISEDITABLE,    // FIELD_vizinhoExcluido
+        FD_ISEDITABLE,    // FIELD_epoca
+        FD_ISEDITABLE,    // FIELD_anunciosEpoca
+        FD_ISEDITABLE,    // FIELD_destino
+        FD_ISEDITABLE,    // FIELD_saltos
     };
-    return (field >= 0 && field < 3) ? fieldTypeFlags[field] : 0;
+    return (field >= 0 && field < 8) ? fieldTypeFlags[field] : 0;
 }
 
 const char *MensagemDescriptor::getFieldName(int field) const
@@ -469,10 +436,17 @@ const char *MensagemDescriptor::getFieldName(int field) const
     }
     static const char *fieldNames[] = {
         "idNoOrigem",
-        "destinos",
-        "custos",
+        "numeroSequencia",
+        "completa",
+        "ultimaAlteracao",
+        "anuncio",
+        "vizinhoExcluido",
+        "epoca",
+        "anunciosEpoca",
+        "destino",
+        "saltos",
     };
-    return (field >= 0 && field < 3) ? fieldNames[field] : nullptr;
+    return (field >= 0 && field < 8) ? fieldNames[field] : nullptr;
 }
 
 int MensagemDescriptor::findField(const char *fieldName) const
@@ -480,8 +454,15 @@ int MensagemDescriptor::findField(const char *fieldName) const
     omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
     int baseIndex = base ? base->getFieldCount() : 0;
     if (strcmp(fieldName, "idNoOrigem") == 0) return baseIndex + 0;
-    if (strcmp(fieldName, "destinos") == 0) return baseIndex + 1;
-    if (strcmp(fieldName, "custos") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "numeroSequencia") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "completa") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "ultimaAlteracao") == 0) return baseIndex + 3;
+    if (strcmp(fieldName, "anuncio") == 0) return baseIndex + 4;
+    if (strcmp(fieldName, "vizinhoExcluido") == 0) return baseIndex + 5;
+    if (strcmp(fieldName, "epoca") == 0) return baseIndex + 6;
+    if (strcmp(fieldName, "anunciosEpoca") == 0) return baseIndex + 7;
+    if (strcmp(fieldName, "destino") == 0) return baseIndex + 8;
+    if (strcmp(fieldName, "saltos") == 0) return baseIndex + 9;
     return base ? base->findField(fieldName) : -1;
 }
 
@@ -495,10 +476,17 @@ const char *MensagemDescriptor::getFieldTypeString(int field) const
     }
     static const char *fieldTypeStrings[] = {
         "int",    // FIELD_idNoOrigem
-        "int",    // FIELD_destinos
-        "double",    // FIELD_custos
+        "int",    // FIELD_numeroSequencia
+        "bool",    // FIELD_completa
+        "omnetpp::simtime_t",    // FIELD_ultimaAlteracao
+        "AnuncioTabelaPtr",    // FIELD_anuncio
+        "int",    // FIELD_vizinhoExcluido
+        "int",    // FIELD_epoca
+        "int",    // FIELD_anunciosEpoca
+        "int",    // FIELD_destino
+        "int",    // FIELD_saltos
     };
-    return (field >= 0 && field < 3) ? fieldTypeStrings[field] : nullptr;
+    return (field >= 0 && field < 8) ? fieldTypeStrings[field] : nullptr;
 }
 
 const char **MensagemDescriptor::getFieldPropertyNames(int field) const
@@ -537,8 +525,6 @@ int MensagemDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) co
     }
     Mensagem *pp = omnetpp::fromAnyPtr<Mensagem>(object); (void)pp;
     switch (field) {
-        case FIELD_destinos: return pp->getDestinosArraySize();
-        case FIELD_custos: return pp->getCustosArraySize();
         default: return 0;
     }
 }
@@ -555,8 +541,6 @@ void MensagemDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, i
     }
     Mensagem *pp = omnetpp::fromAnyPtr<Mensagem>(object); (void)pp;
     switch (field) {
-        case FIELD_destinos: pp->setDestinosArraySize(size); break;
-        case FIELD_custos: pp->setCustosArraySize(size); break;
         default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'Mensagem'", field);
     }
 }
@@ -586,8 +570,15 @@ std::string MensagemDescriptor::getFieldValueAsString(omnetpp::any_ptr object, i
     Mensagem *pp = omnetpp::fromAnyPtr<Mensagem>(object); (void)pp;
     switch (field) {
         case FIELD_idNoOrigem: return long2string(pp->getIdNoOrigem());
-        case FIELD_destinos: return long2string(pp->getDestinos(i));
-        case FIELD_custos: return double2string(pp->getCustos(i));
+        case FIELD_numeroSequencia: return long2string(pp->getNumeroSequencia());
+        case FIELD_completa: return bool2string(pp->getCompleta());
+        case FIELD_ultimaAlteracao: return simtime2string(pp->getUltimaAlteracao());
+        case FIELD_anuncio: return anuncioParaString(pp->getAnuncio());
+        case FIELD_vizinhoExcluido: return long2string(pp->getVizinhoExcluido());
+        case FIELD_epoca: return long2string(pp->getEpoca());
+        case FIELD_anunciosEpoca: return long2string(pp->getAnunciosEpoca());
+        case FIELD_destino: return long2string(pp->getDestino());
+        case FIELD_saltos: return long2string(pp->getSaltos());
         default: return "";
     }
 }
@@ -605,8 +596,14 @@ void MensagemDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int fiel
     Mensagem *pp = omnetpp::fromAnyPtr<Mensagem>(object); (void)pp;
     switch (field) {
         case FIELD_idNoOrigem: pp->setIdNoOrigem(string2long(value)); break;
-        case FIELD_destinos: pp->setDestinos(i,string2long(value)); break;
-        case FIELD_custos: pp->setCustos(i,string2double(value)); break;
+        case FIELD_numeroSequencia: pp->setNumeroSequencia(string2long(value)); break;
+        case FIELD_completa: pp->setCompleta(string2bool(value)); break;
+        case FIELD_ultimaAlteracao: pp->setUltimaAlteracao(string2simtime(value)); break;
+        case FIELD_vizinhoExcluido: pp->setVizinhoExcluido(string2long(value)); break;
+        case FIELD_epoca: pp->setEpoca(string2long(value)); break;
+        case FIELD_anunciosEpoca: pp->setAnunciosEpoca(string2long(value)); break;
+        case FIELD_destino: pp->setDestino(string2long(value)); break;
+        case FIELD_saltos: pp->setSaltos(string2long(value)); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'Mensagem'", field);
     }
 }
@@ -622,8 +619,15 @@ omnetpp::cValue MensagemDescriptor::getFieldValue(omnetpp::any_ptr object, int f
     Mensagem *pp = omnetpp::fromAnyPtr<Mensagem>(object); (void)pp;
     switch (field) {
         case FIELD_idNoOrigem: return pp->getIdNoOrigem();
-        case FIELD_destinos: return pp->getDestinos(i);
-        case FIELD_custos: return pp->getCustos(i);
+        case FIELD_numeroSequencia: return pp->getNumeroSequencia();
+        case FIELD_completa: return pp->getCompleta();
+        case FIELD_ultimaAlteracao: return pp->getUltimaAlteracao().dbl();
+        case FIELD_anuncio: return omnetpp::toAnyPtr(&pp->getAnuncio()); break;
+        case FIELD_vizinhoExcluido: return pp->getVizinhoExcluido();
+        case FIELD_epoca: return pp->getEpoca();
+        case FIELD_anunciosEpoca: return pp->getAnunciosEpoca();
+        case FIELD_destino: return pp->getDestino();
+        case FIELD_saltos: return pp->getSaltos();
         default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'Mensagem' as cValue -- field index out of range?", field);
     }
 }
@@ -641,8 +645,14 @@ void MensagemDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i
     Mensagem *pp = omnetpp::fromAnyPtr<Mensagem>(object); (void)pp;
     switch (field) {
         case FIELD_idNoOrigem: pp->setIdNoOrigem(omnetpp::checked_int_cast<int>(value.intValue())); break;
-        case FIELD_destinos: pp->setDestinos(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
-        case FIELD_custos: pp->setCustos(i,value.doubleValue()); break;
+        case FIELD_numeroSequencia: pp->setNumeroSequencia(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_completa: pp->setCompleta(value.boolValue()); break;
+        case FIELD_ultimaAlteracao: pp->setUltimaAlteracao(value.doubleValue()); break;
+        case FIELD_vizinhoExcluido: pp->setVizinhoExcluido(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_epoca: pp->setEpoca(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_anunciosEpoca: pp->setAnunciosEpoca(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_destino: pp->setDestino(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_saltos: pp->setSaltos(omnetpp::checked_int_cast<int>(value.intValue())); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'Mensagem'", field);
     }
 }
@@ -17,14 +17,53 @@
 #endif
 
 class Mensagem;
+// cplusplus {{
+#include "AnuncioTabela.h"
+// }}
+
+/**
+ * Enum generated from <tt>src/Mensagem.msg:12</tt> by opp_msgtool.
+ * <pre>
+ * enum TipoMensagem
+ * {
+ *     MSG_PROPAGACAO = 0;      // Anúncio de tabela (mensagem básica do PI)
+ *     MSG_CONFIRMACAO = 1;     // Confirmação de Dijkstra-Scholten ao remetente
+ *     MSG_CONVERGENCIA = 2;    // Aviso global de convergência difundido pela raiz
+ *     MSG_SONDAGEM = 3;        // Onda de eco do coordenador (ida): várias origens ou cenário dinâmico
+ *     MSG_ECO = 4;             // Resposta da onda de eco ao pai na onda
+ *     MSG_ESTADO_ENLACE = 5;   // Anúncio de estado de enlace (RoteadorEstadoEnlace), inundado pela rede
+ *     MSG_DADOS = 6;           // Pacote do plano de dados, encaminhado pelos próximos saltos da tabela
+ * }
+ * </pre>
+ */
+enum TipoMensagem {
+    MSG_PROPAGACAO = 0,
+    MSG_CONFIRMACAO = 1,
+    MSG_CONVERGENCIA = 2,
+    MSG_SONDAGEM = 3,
+    MSG_ECO = 4,
+    MSG_ESTADO_ENLACE = 5,
+    MSG_DADOS = 6
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const TipoMensagem& e) { b->pack(static_cast<int>(e)); }
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, TipoMensagem& e) { int n; b->unpack(n); e = static_cast<TipoMensagem>(n); }
+
 /**
- * Class generated from <tt>src/Mensagem.msg:2</tt> by opp_msgtool.
+ * Class generated from <tt>src/Mensagem.msg:22</tt> by opp_msgtool.
  * <pre>
  * packet Mensagem
  * {
  *     int idNoOrigem;
- *     int destinos[];
- *     double custos[];
+ *     int numeroSequencia;     // Sequência do anúncio na porta de saída
+ *     bool completa = true;    // true: tabela completa; false: apenas alterações (delta)
+ *     simtime_t ultimaAlteracao;  // Confirmação/convergência: última alteração de tabela conhecida
+ *     AnuncioTabelaPtr anuncio;   // Retrato da tabela, compartilhado (sem cópia) entre as portas
+ *     int vizinhoExcluido = -1;   // Horizonte dividido: entradas com este próximo salto não valem para o receptor
+ *     int epoca;                  // Sondagem/eco: instante do cenário a que a onda se refere (0 = partida)
+ *     int anunciosEpoca;          // Eco: anúncios enviados na subárvore de eco desde o início da época
+ *     int destino = -1;           // Dados: endereço de destino (idNoOrigem é a fonte)
+ *     int saltos;                 // Dados: enlaces já percorridos
  * }
  * </pre>
  */
@@ -32,10 +71,15 @@ class Mensagem : public ::omnetpp::cPacket
 {
   protected:
     int idNoOrigem = 0;
-    int *destinos = nullptr;
-    size_t destinos_arraysize = 0;
-    double *custos = nullptr;
-    size_t custos_arraysize = 0;
+    int numeroSequencia = 0;
+    bool completa = true;
+    omnetpp::simtime_t ultimaAlteracao = SIMTIME_ZERO;
+    AnuncioTabelaPtr anuncio;
+    int vizinhoExcluido = -1;
+    int epoca = 0;
+    int anunciosEpoca = 0;
+    int destino = -1;
+    int saltos = 0;
 
   private:
     void copy(const Mensagem& other);
@@ -55,23 +99,39 @@ class Mensagem : public ::omnetpp::cPacket
     virtual int getIdNoOrigem() const;
     virtual void setIdNoOrigem(int idNoOrigem);
 
-    virtual void setDestinosArraySize(size_t size);
-    virtual size_t getDestinosArraySize() const;
-    virtual int getDestinos(size_t k) const;
-    virtual void setDestinos(size_t k, int destinos);
-    virtual void insertDestinos(size_t k, int destinos);
-    [[deprecated]] void insertDestinos(int destinos) {appendDestinos(destinos);}
-    virtual void appendDestinos(int destinos);
-    virtual void eraseDestinos(size_t k);
-
-    virtual void setCustosArraySize(size_t size);
-    virtual size_t getCustosArraySize() const;
-    virtual double getCustos(size_t k) const;
-    virtual void setCustos(size_t k, double custos);
-    virtual void insertCustos(size_t k, double custos);
-    [[deprecated]] void insertCustos(double custos) {appendCustos(custos);}
-    virtual void appendCustos(double custos);
-    virtual void eraseCustos(size_t k);
+    virtual int getNumeroSequencia() const;
+    virtual void setNumeroSequencia(int numeroSequencia);
+
+    virtual bool getCompleta() const;
+    virtual void setCompleta(bool completa);
+
+    virtual omnetpp::simtime_t getUltimaAlteracao() const;
+    virtual void setUltimaAlteracao(omnetpp::simtime_t ultimaAlteracao);
+
+    virtual const AnuncioTabelaPtr& getAnuncio() const;
+    virtual AnuncioTabelaPtr& getAnuncioForUpdate() { return const_cast<AnuncioTabelaPtr&>(const_cast<Mensagem*>(this)->getAnuncio());}
+    virtual void setAnuncio(const AnuncioTabelaPtr& anuncio);
+
+    virtual int getVizinhoExcluido() const;
+    virtual void setVizinhoExcluido(int vizinhoExcluido);
+
+    virtual int getEpoca() const;
+    virtual void setEpoca(int epoca);
+
+    virtual int getAnunciosEpoca() const;
+    virtual void setAnunciosEpoca(int anunciosEpoca);
+
+    virtual int getDestino() const;
+    virtual void setDestino(int destino);
+
+    virtual int getSaltos() const;
+    virtual void setSaltos(int saltos);
+
+    // cplusplus {{
+  public:
+    static void *operator new(size_t tamanho) { return ArenaClasses::alocar(tamanho); }
+    static void operator delete(void *bloco, size_t tamanho) { ArenaClasses::liberar(bloco, tamanho); }
+    // }}
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const Mensagem& obj) {obj.parsimPack(b);}
@@ -0,0 +1,96 @@
+// Divisão do grafo em áreas conexas com endereços numerados por área
+
+#include "ParticaoAreas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+
+int ParticaoAreas::numerar(int numNos, const std::vector<Aresta>& arestas, int tamanhoArea,
+                           std::vector<int>& enderecos) {
+    if (numNos < 0 || tamanhoArea <= 0) {
+        throw std::invalid_argument("ParticaoAreas: numNos negativo ou tamanhoArea não positivo");
+    }
+
+    std::vector<std::vector<int>> adjacentes(numNos);
+    for (size_t i = 0; i < arestas.size(); i++) {
+        adjacentes[arestas[i].first].push_back(arestas[i].second);
+        adjacentes[arestas[i].second].push_back(arestas[i].first);
+    }
+
+    // Sementes: a busca de cada uma só avança enquanto encurta a distância até a semente mais
+    // próxima. A folga de 3/4 deixa espaço nas áreas para poucos nós ficarem cercados
+    int numSementes = (4 * (int64_t)numNos + 3 * tamanhoArea - 1) / (3 * tamanhoArea);
+    std::vector<int> sementes;
+    std::vector<int> distancias(numNos, INT_MAX);
+    std::vector<int> fila;
+    int semente = 0;
+    while ((int)sementes.size() < numSementes) {
+        sementes.push_back(semente);
+        distancias[semente] = 0;
+        fila.assign(1, semente);
+        for (size_t k = 0; k < fila.size(); k++) {
+            const std::vector<int>& vizinhos = adjacentes[fila[k]];
+            for (size_t j = 0; j < vizinhos.size(); j++) {
+                if (distancias[vizinhos[j]] > distancias[fila[k]] + 1) {
+                    distancias[vizinhos[j]] = distancias[fila[k]] + 1;
+                    fila.push_back(vizinhos[j]);
+                }
+            }
+        }
+        semente = std::max_element(distancias.begin(), distancias.end()) - distancias.begin();
+        if (distancias[semente] == 0) {
+            break;
+        }
+    }
+
+    // As áreas crescem juntas, em uma busca em largura a partir de todas as sementes; um nó
+    // entra na área de quem o alcançou primeiro, se ela ainda tiver menos de tamanhoArea nós
+    int numAreas = 0;
+    enderecos.assign(numNos, -1);
+    std::vector<int> areaDoNo(numNos, -1);
+    std::vector<int> ocupados;
+    fila.clear();
+    for (size_t k = 0; k < sementes.size(); k++) {
+        areaDoNo[sementes[k]] = numAreas;
+        enderecos[sementes[k]] = numAreas * tamanhoArea;
+        ocupados.push_back(1);
+        fila.push_back(sementes[k]);
+        numAreas++;
+    }
+    for (size_t k = 0; k < fila.size(); k++) {
+        int area = areaDoNo[fila[k]];
+        const std::vector<int>& vizinhos = adjacentes[fila[k]];
+        for (size_t j = 0; j < vizinhos.size() && ocupados[area] < tamanhoArea; j++) {
+            if (enderecos[vizinhos[j]] < 0) {
+                areaDoNo[vizinhos[j]] = area;
+                enderecos[vizinhos[j]] = area * tamanhoArea + ocupados[area]++;
+                fila.push_back(vizinhos[j]);
+            }
+        }
+    }
+
+    // Nós cercados por áreas cheias formam áreas novas, do mesmo modo a partir do menor
+    // deles; assim toda área é conexa
+    for (int inicio = 0; inicio < numNos; inicio++) {
+        if (enderecos[inicio] >= 0) {
+            continue;
+        }
+        int primeiro = numAreas * tamanhoArea;
+        int numOcupados = 1;
+        enderecos[inicio] = primeiro;
+        fila.assign(1, inicio);
+        for (size_t k = 0; k < fila.size() && numOcupados < tamanhoArea; k++) {
+            const std::vector<int>& vizinhos = adjacentes[fila[k]];
+            for (size_t j = 0; j < vizinhos.size() && numOcupados < tamanhoArea; j++) {
+                if (enderecos[vizinhos[j]] < 0) {
+                    enderecos[vizinhos[j]] = primeiro + numOcupados++;
+                    fila.push_back(vizinhos[j]);
+                }
+            }
+        }
+        numAreas++;
+    }
+    return numAreas;
+}
@@ -0,0 +1,23 @@
+#ifndef __PROVA_PARTICAOAREAS_H_
+#define __PROVA_PARTICAOAREAS_H_
+
+#include <utility>
+#include <vector>
+
+// Divisão de um grafo em áreas conexas para o roteamento hierárquico (parâmetro tamanhoArea
+// do Roteador), com os endereços numerados por área: a área k ocupa os endereços de
+// k * tamanhoArea até (k + 1) * tamanhoArea - 1. Não depende do OMNeT++.
+//
+// As áreas crescem juntas em uma busca em largura a partir de sementes espalhadas (cada uma
+// o nó mais distante, em saltos, das anteriores), uma a cada 3/4 de tamanhoArea nós. Os nós
+// que ficam cercados por áreas cheias formam áreas novas com os vizinhos livres.
+class ParticaoAreas {
+  public:
+    typedef std::pair<int, int> Aresta;
+
+    // Preenche enderecos[v] para os nós 0..numNos-1 e retorna o número de áreas
+    static int numerar(int numNos, const std::vector<Aresta>& arestas, int tamanhoArea,
+                       std::vector<int>& enderecos);
+};
+
+#endif
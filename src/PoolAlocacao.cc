@@ -0,0 +1,180 @@
+// Arena por classes de tamanho, pool de retratos de tabela e contagem das alocações do processo
+
+#include "PoolAlocacao.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+#include "AnuncioTabela.h"
+
+namespace {
+
+struct EstadoArena {
+    void *livres[ArenaClasses::MAIOR_BLOCO / ArenaClasses::GRANULARIDADE] = {};  // Lista livre de cada classe
+    char *pedacoAtual = nullptr;
+    size_t restanteNoPedaco = 0;
+    ArenaClasses::Estatisticas estatisticas;
+};
+
+struct EstadoAnuncios {
+    std::vector<AnuncioTabela *> livres;
+    size_t bytesLivres = 0;
+    PoolAnuncios::Estatisticas estatisticas;
+};
+
+// Nunca destruídos: mensagens e retratos ainda podem ser liberados durante a destruição
+// de outros objetos estáticos no fim do processo
+EstadoArena& estadoArena() {
+    static EstadoArena *estado = new EstadoArena();
+    return *estado;
+}
+
+EstadoAnuncios& estadoAnuncios() {
+    static EstadoAnuncios *estado = new EstadoAnuncios();
+    return *estado;
+}
+
+size_t bytesRetidos(const AnuncioTabela& anuncio) {
+    return anuncio.destinos.capacity() * sizeof(int) + anuncio.custos.capacity() * sizeof(double)
+           + anuncio.proximosSaltos.capacity() * sizeof(int) + anuncio.inicioCaminho.capacity() * sizeof(int)
+           + anuncio.nosCaminho.capacity() * sizeof(int);
+}
+
+}  // namespace
+
+void *ArenaClasses::alocar(size_t tamanho) {
+#ifndef PROVA_SEM_POOL
+    if (tamanho <= MAIOR_BLOCO) {
+        EstadoArena& arena = estadoArena();
+        arena.estatisticas.alocacoes++;
+        size_t classe = tamanho == 0 ? 0 : (tamanho - 1) / GRANULARIDADE;
+        void *bloco = arena.livres[classe];
+        if (bloco != nullptr) {
+            // O bloco livre guarda o endereço do próximo da lista
+            arena.livres[classe] = *static_cast<void **>(bloco);
+            arena.estatisticas.reaproveitadas++;
+            return bloco;
+        }
+        // O que sobra no fim do pedaço (menos que um bloco) é descartado
+        size_t bytes = (classe + 1) * GRANULARIDADE;
+        if (arena.restanteNoPedaco < bytes) {
+            arena.pedacoAtual = static_cast<char *>(::operator new(TAMANHO_PEDACO));
+            arena.restanteNoPedaco = TAMANHO_PEDACO;
+            arena.estatisticas.pedacos++;
+        }
+        bloco = arena.pedacoAtual;
+        arena.pedacoAtual += bytes;
+        arena.restanteNoPedaco -= bytes;
+        return bloco;
+    }
+#endif
+    return ::operator new(tamanho);
+}
+
+void ArenaClasses::liberar(void *bloco, size_t tamanho) noexcept {
+    if (bloco == nullptr) {
+        return;
+    }
+#ifndef PROVA_SEM_POOL
+    if (tamanho <= MAIOR_BLOCO) {
+        EstadoArena& arena = estadoArena();
+        size_t classe = tamanho == 0 ? 0 : (tamanho - 1) / GRANULARIDADE;
+        *static_cast<void **>(bloco) = arena.livres[classe];
+        arena.livres[classe] = bloco;
+        return;
+    }
+#endif
+    ::operator delete(bloco);
+}
+
+const ArenaClasses::Estatisticas& ArenaClasses::estatisticas() {
+    return estadoArena().estatisticas;
+}
+
+std::shared_ptr<AnuncioTabela> PoolAnuncios::obter() {
+    EstadoAnuncios& pool = estadoAnuncios();
+    pool.estatisticas.obtidos++;
+#ifdef PROVA_SEM_POOL
+    return std::make_shared<AnuncioTabela>();
+#else
+    AnuncioTabela *anuncio;
+    if (!pool.livres.empty()) {
+        anuncio = pool.livres.back();
+        pool.livres.pop_back();
+        pool.bytesLivres -= bytesRetidos(*anuncio);
+        pool.estatisticas.reaproveitados++;
+    } else {
+        anuncio = new AnuncioTabela();
+    }
+    return std::shared_ptr<AnuncioTabela>(anuncio, &PoolAnuncios::devolver, AlocadorArena<AnuncioTabela>());
+#endif
+}
+
+void PoolAnuncios::devolver(AnuncioTabela *anuncio) {
+    // Esvazia sem liberar a capacidade dos vetores
+    anuncio->destinos.clear();
+    anuncio->custos.clear();
+    anuncio->proximosSaltos.clear();
+    anuncio->bytesEntradas = 0;
+    anuncio->numInternas = 0;
+    anuncio->bytesInternas = 0;
+    anuncio->inicioCaminho.clear();
+    anuncio->nosCaminho.clear();
+
+    EstadoAnuncios& pool = estadoAnuncios();
+    size_t bytes = bytesRetidos(*anuncio);
+    if (pool.livres.size() >= MAXIMO_LIVRES || pool.bytesLivres + bytes > LIMITE_BYTES) {
+        pool.estatisticas.descartados++;
+        delete anuncio;
+        return;
+    }
+    pool.livres.push_back(anuncio);
+    pool.bytesLivres += bytes;
+}
+
+const PoolAnuncios::Estatisticas& PoolAnuncios::estatisticas() {
+    return estadoAnuncios().estatisticas;
+}
+
+#ifdef PROVA_CONTAR_ALOCACOES
+
+// Substitui o operator new global do processo inteiro (simulação, OMNeT++ e bibliotecas).
+// As variantes de vetor e nothrow da biblioteca padrão chamam esta
+static std::atomic<uint64_t> alocacoesGlobais(0);
+
+void *operator new(size_t tamanho) {
+    alocacoesGlobais.fetch_add(1, std::memory_order_relaxed);
+    void *bloco = std::malloc(tamanho == 0 ? 1 : tamanho);
+    if (bloco == nullptr) {
+        throw std::bad_alloc();
+    }
+    return bloco;
+}
+
+void operator delete(void *bloco) noexcept {
+    std::free(bloco);
+}
+
+void operator delete(void *bloco, size_t) noexcept {
+    std::free(bloco);
+}
+
+bool contandoAlocacoes() {
+    return true;
+}
+
+uint64_t alocacoesDoProcesso() {
+    return alocacoesGlobais.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool contandoAlocacoes() {
+    return false;
+}
+
+uint64_t alocacoesDoProcesso() {
+    return 0;
+}
+
+#endif
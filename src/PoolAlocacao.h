@@ -0,0 +1,86 @@
+#ifndef __PROVA_POOLALOCACAO_H_
+#define __PROVA_POOLALOCACAO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+// Alocação dos objetos de vida curta que a simulação cria a cada evento: as mensagens
+// (operator new/delete da classe Mensagem, em Mensagem.msg) e os retratos de tabela dos
+// anúncios. Não depende do OMNeT++. A simulação roda em uma única thread por processo, e
+// as estruturas não são protegidas para uso concorrente.
+//
+// Compilado com PROVA_SEM_POOL ("make POOL=0"), tudo vai direto ao alocador do sistema,
+// para comparar o desempenho.
+
+struct AnuncioTabela;
+
+// Blocos pequenos agrupados em classes de tamanho (múltiplos de GRANULARIDADE). Um bloco
+// liberado entra na lista livre da sua classe e é o próximo a ser entregue; blocos novos
+// são cortados de pedaços de TAMANHO_PEDACO bytes, que só voltam ao sistema no fim do
+// processo. A memória retida é, portanto, o pico de objetos vivos de cada classe.
+class ArenaClasses {
+  public:
+    static constexpr size_t GRANULARIDADE = 16;
+    static constexpr size_t MAIOR_BLOCO = 512;        // Acima disso, vai direto ao operator new global
+    static constexpr size_t TAMANHO_PEDACO = 64 * 1024;
+
+    struct Estatisticas {
+        uint64_t alocacoes = 0;        // Pedidos atendidos pela arena
+        uint64_t reaproveitadas = 0;   // ... com um bloco liberado antes
+        uint64_t pedacos = 0;          // Pedaços pedidos ao sistema
+    };
+
+    static void *alocar(size_t tamanho);
+    static void liberar(void *bloco, size_t tamanho) noexcept;
+    static const Estatisticas& estatisticas();
+};
+
+// Alocador de STL sobre a ArenaClasses (blocos de controle dos shared_ptr dos retratos)
+template <typename T>
+struct AlocadorArena {
+    typedef T value_type;
+
+    AlocadorArena() = default;
+    template <typename U>
+    AlocadorArena(const AlocadorArena<U>&) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(ArenaClasses::alocar(n * sizeof(T))); }
+    void deallocate(T *p, size_t n) noexcept { ArenaClasses::liberar(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const AlocadorArena<T>&, const AlocadorArena<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const AlocadorArena<T>&, const AlocadorArena<U>&) { return false; }
+
+// Retratos de tabela liberados (quando a última mensagem que os referencia é apagada)
+// voltam vazios, mas com a capacidade dos vetores, e o próximo anúncio os preenche sem
+// alocar. A memória retida é limitada: um retrato que passaria de LIMITE_BYTES somado aos
+// livres, ou além de MAXIMO_LIVRES, é apagado.
+class PoolAnuncios {
+  public:
+    static constexpr size_t MAXIMO_LIVRES = 1024;
+    static constexpr size_t LIMITE_BYTES = 64 << 20;
+
+    struct Estatisticas {
+        uint64_t obtidos = 0;          // Retratos entregues
+        uint64_t reaproveitados = 0;   // ... que vieram da lista de livres
+        uint64_t descartados = 0;      // Devolvidos, mas apagados pelo limite
+    };
+
+    // Retrato vazio; volta ao pool quando o último shared_ptr é destruído
+    static std::shared_ptr<AnuncioTabela> obter();
+    static const Estatisticas& estatisticas();
+
+  private:
+    static void devolver(AnuncioTabela *anuncio);
+};
+
+// Alocações feitas pelo operator new global desde o início do processo. Só são contadas
+// se compilado com PROVA_CONTAR_ALOCACOES ("make CONTAR_ALOCACOES=1"); sem isso, retorna 0
+bool contandoAlocacoes();
+uint64_t alocacoesDoProcesso();
+
+#endif
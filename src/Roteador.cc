@@ -1,46 +1,66 @@
 // Implementação baseada em PI (Propagação de Informação) para Roteamento com Menor Custo
 // Algoritmo distribuído onde cada nó propaga suas informações de roteamento para os vizinhos
 
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <fstream>
 #include "Roteador.h"
+#include "SolucionadorReferencia.h"
 
 Define_Module(Roteador);
 
-int Roteador::extrairNumeroNo(const std::string& nomeNo) {
-    // Tenta diferentes estratégias para extrair o número
-    
-    // Estratégia 1: Procura por "no" seguido de número
-    size_t pos = nomeNo.find("no");
-    if (pos != std::string::npos && pos + 2 < nomeNo.length()) {
-        std::string numeroStr = nomeNo.substr(pos + 2);
-        // Remove caracteres não numéricos
-        std::string numeroLimpo;
-        for (char c : numeroStr) {
-            if (c >= '0' && c <= '9') {
-                numeroLimpo += c;
-            }
-        }
-        if (!numeroLimpo.empty()) {
-            return std::stoi(numeroLimpo);
-        }
-    }
-    
-    // Estratégia 2: Procura por "." seguido de "no" e número
-    pos = nomeNo.find_last_of('.');
-    if (pos != std::string::npos && pos + 1 < nomeNo.length()) {
-        std::string nomeModulo = nomeNo.substr(pos + 1);
-        if (nomeModulo.substr(0, 2) == "no" && nomeModulo.length() > 2) {
-            std::string numeroStr = nomeModulo.substr(2);
-            return std::stoi(numeroStr);
-        }
+simsignal_t Roteador::sinalRotasConhecidas = registerSignal("rotasConhecidas");
+simsignal_t Roteador::sinalSomaCustos = registerSignal("somaCustos");
+simsignal_t Roteador::sinalMensagensEmTransito = registerSignal("mensagensEmTransito");
+simsignal_t Roteador::sinalAlteracoesPorFase = registerSignal("alteracoesPorFase");
+simsignal_t Roteador::sinalTempoProcessamento = registerSignal("tempoProcessamento");
+simsignal_t Roteador::sinalAtrasoPacote = registerSignal("atrasoPacote");
+simsignal_t Roteador::sinalSaltosPacote = registerSignal("saltosPacote");
+simsignal_t Roteador::sinalPacoteDescartado = registerSignal("pacoteDescartado");
+
+bool Roteador::inicioEventosMarcado = false;
+eventnumber_t Roteador::eventoInicial = 0;
+uint64_t Roteador::alocacoesNoInicio = 0;
+ArenaClasses::Estatisticas Roteador::arenaNoInicio;
+PoolAnuncios::Estatisticas Roteador::anunciosNoInicio;
+
+std::vector<int> Roteador::enderecosRede;
+bool Roteador::enderecosColetados = false;
+bool Roteador::paredeDadosMarcada = false;
+std::chrono::steady_clock::time_point Roteador::inicioParedeDados;
+std::chrono::steady_clock::time_point Roteador::fimParedeDados;
+
+Roteador::~Roteador() {
+    cancelAndDelete(temporizadorSincronizacao);
+    cancelAndDelete(temporizadorAgrupamento);
+    cancelAndDelete(temporizadorCenario);
+    cancelAndDelete(temporizadorTrafego);
+}
+
+// Atributo obrigatório de um <evento> do cenário
+static const char *atributoEvento(cXMLElement *evento, const char *nome) {
+    const char *valor = evento->getAttribute(nome);
+    if (valor == nullptr) {
+        throw cRuntimeError("Evento do cenário sem o atributo '%s' (%s)", nome, evento->getSourceLocation());
     }
-    
-    return -1;
+    return valor;
 }
 
 void Roteador::initialize() {
+    // Nível de log: o parâmetro só reduz o que foi compilado (PROVA_NIVEL_LOG)
+    nivelLog = lerNivelLog(this);
+    
     meuId = getId();
     WATCH(meuId);
     
+    // Nova execução no mesmo processo: as alocações por evento voltam a ser contadas do início,
+    // e os endereços da rede e o tempo de parede do plano de dados são coletados de novo
+    inicioEventosMarcado = false;
+    enderecosColetados = false;
+    paredeDadosMarcada = false;
+    
     // Inicialização das métricas
     totalMensagensEnviadas = 0;
     totalMensagensRecebidas = 0;
@@ -52,20 +72,109 @@ void Roteador::initialize() {
     faseAtual = 0;
     aguardandoSincronizacao = false;
     
-    // Obtém o nome do nó (no0, no1, no2, etc.)
-    std::string nomeNo = getFullName();
-    int numeroNo = extrairNumeroNo(nomeNo);
+    // Configuração da propagação: tabela completa ou apenas alterações (delta)
+    std::string modoPropagacao = par("modoPropagacao").stdstringValue();
+    if (modoPropagacao != "completo" && modoPropagacao != "delta") {
+        throw cRuntimeError("modoPropagacao inválido: '%s' (use \"completo\" ou \"delta\")", modoPropagacao.c_str());
+    }
+    modoDelta = (modoPropagacao == "delta");
+    intervaloSincronizacao = par("intervaloSincronizacao").doubleValue();
+    versaoTabela = 0;
+    versaoSincronizada = 0;
+    totalEntradasEnviadas = 0;
+    totalAnunciosCompletos = 0;
+    totalAnunciosDelta = 0;
+    totalLacunasSequencia = 0;
     
-    // Verifica se a extração funcionou
-    if (numeroNo == -1) {
-        EV << "ERRO CRÍTICO: Não foi possível extrair número do nó!" << endl;
-        return;
+    // Agrupamento de atualizações: melhorias próximas no tempo geram um único anúncio
+    janelaAgrupamento = par("janelaAgrupamento").doubleValue();
+    totalAtualizacoesAgrupadas = 0;
+    if (janelaAgrupamento > 0) {
+        temporizadorAgrupamento = new cMessage("AgruparPI");
+    }
+    
+    // Horizonte dividido: filtra, por porta, as rotas aprendidas pelo próprio vizinho
+    std::string modoHorizonte = par("horizonteDividido").stdstringValue();
+    if (modoHorizonte == "desativado") {
+        horizonteDividido = HORIZONTE_DESATIVADO;
+    } else if (modoHorizonte == "simples") {
+        horizonteDividido = HORIZONTE_SIMPLES;
+    } else if (modoHorizonte == "reversoEnvenenado") {
+        horizonteDividido = HORIZONTE_REVERSO_ENVENENADO;
+    } else {
+        throw cRuntimeError("horizonteDividido inválido: '%s' (use \"desativado\", \"simples\" ou \"reversoEnvenenado\")", modoHorizonte.c_str());
+    }
+    totalEntradasSuprimidas = 0;
+    totalEntradasEnvenenadas = 0;
+    
+    // Codificação das mensagens: define o tamanho em bytes e a quantização dos custos
+    std::string formato = par("codificacao").stdstringValue();
+    if (formato != "nativa" && formato != "compacta") {
+        throw cRuntimeError("codificacao inválida: '%s' (use \"nativa\" ou \"compacta\")", formato.c_str());
     }
+    double resolucaoCusto = par("resolucaoCusto").doubleValue();
+    if (resolucaoCusto < 0) {
+        throw cRuntimeError("resolucaoCusto não pode ser negativa");
+    }
+    codificacao.configurar(formato == "compacta" ? CodificacaoAnuncio::FORMATO_COMPACTO : CodificacaoAnuncio::FORMATO_NATIVO,
+                           resolucaoCusto, par("destinosImplicitos").boolValue());
+    totalBytesEnviados = 0;
+    
+    // Vetor de caminho: cada anúncio leva o caminho das rotas, e o receptor descarta laços
+    vetorCaminho = par("vetorCaminho").boolValue();
+    totalCaminhosRejeitados = 0;
     
-    // Inicializa a tabela de roteamento com informação local
-    tabelaRoteamento[numeroNo] = 0.0;
-    proximosSaltos[numeroNo] = numeroNo;
-    destinosConhecidos.push_back(numeroNo);
+    // Hierarquia de áreas: os índices da tabela deixam de ser endereços, então os recursos
+    // que os tratam como endereços (caminhos, exportações e a Adj-RIB-In do cenário) ficam de fora
+    tamanhoArea = par("tamanhoArea").intValue();
+    totalEntradasResumidas = 0;
+    if (tamanhoArea < 0) {
+        throw cRuntimeError("tamanhoArea não pode ser negativo");
+    }
+    if (tamanhoArea > 0 && (vetorCaminho || !par("arquivoTopologia").stdstringValue().empty()
+                            || !par("arquivoTabelas").stdstringValue().empty()
+                            || !par("arquivoTabelasBinario").stdstringValue().empty())) {
+        throw cRuntimeError("tamanhoArea não é suportado com vetorCaminho nem com a exportação de tabelas");
+    }
+    
+    // Detecção de terminação: ninguém está engajado antes do início da onda
+    engajado = false;
+    portaPai = -1;
+    deficit = 0;
+    deficitPorPorta.assign(gateSize("portas"), 0);
+    ultimaAlteracaoLocal = SIMTIME_ZERO;
+    ultimaAlteracaoSubarvore = SIMTIME_ZERO;
+    tempoDeteccao = SIMTIME_ZERO;
+    totalMensagensControle = 0;
+    
+    int numPortas = gateSize("portas");
+    vizinhoPorPorta.assign(numPortas, -1);
+    primeiraPortaDoVizinho.assign(numPortas, 0);
+    portaLivreEm.assign(numPortas, SIMTIME_ZERO);
+    versaoAnunciadaPorPorta.assign(numPortas, 0);
+    portaSincronizada.assign(numPortas, false);
+    sequenciaPorPorta.assign(numPortas, 0);
+    sequenciaRecebidaPorPorta.assign(numPortas, -1);
+    custoPorPorta.assign(numPortas, CUSTO_INFINITO);
+    portaAtiva.assign(numPortas, true);
+    
+    // Endereço lógico do nó, resolvido uma única vez (parâmetro, índice ou nome)
+    std::string nomeNo = getFullName();
+    meuEndereco = resolverEndereco(this);
+    if (meuEndereco == -1) {
+        throw cRuntimeError("Não foi possível determinar o endereço do nó '%s' "
+                            "(defina o parâmetro endereco ou use nomes como no0 ou host[0])", nomeNo.c_str());
+    }
+    WATCH(meuEndereco);
+    minhaArea = tamanhoArea > 0 ? meuEndereco / tamanhoArea : 0;
+    
+    // Inicializa a tabela de roteamento com informação local (com hierarquia, o nó também
+    // é a origem da entrada resumida da sua área)
+    tabela.definir(indiceDestino(meuEndereco), 0.0, meuEndereco);
+    if (tamanhoArea > 0) {
+        tabela.definir(tamanhoArea + minhaArea, 0.0, meuEndereco);
+    }
+    EV_NIVEL(LOG_RESUMO) << "Nó " << nomeNo << " usando kernel de relaxação " << TabelaRoteamento::nomeKernel(tabela.getKernel()) << endl;
     
     // Descobre vizinhos diretos e seus custos
     for (int i = 0; i < gateSize("portas"); ++i) {
@@ -77,32 +186,160 @@ void Roteador::initialize() {
             // Lê o custo do canal (delay) - USANDO LINKS COM DELAY
             double custo = canal->par("delay").doubleValue();
             
-            // Obtém o nome do vizinho
-            std::string nomeVizinho = vizinho->getFullName();
-            int numeroVizinho = extrairNumeroNo(nomeVizinho);
+            // Endereço do vizinho guardado por porta: os caminhos quentes não tocam em strings
+            int numeroVizinho = resolverEndereco(vizinho);
             
-            // Verifica se a extração funcionou para o vizinho
+            // Verifica se a resolução funcionou para o vizinho
             if (numeroVizinho != -1) {
-                // Adiciona informação do vizinho direto
-                tabelaRoteamento[numeroVizinho] = custo;
-                proximosSaltos[numeroVizinho] = numeroVizinho;
-                custoVizinhos[numeroVizinho] = custo;
-                destinosConhecidos.push_back(numeroVizinho);
+                // Adiciona informação do vizinho direto (enlaces paralelos até o vizinho e
+                // vizinhos de uma mesma outra área dividem a entrada: fica o mais barato)
+                int indice = indiceDestino(numeroVizinho);
+                if (!tabela.conhece(indice) || custo < tabela.custo(indice)) {
+                    tabela.definir(indice, custo, numeroVizinho);
+                }
+                if (vetorCaminho) {
+                    atribuirCaminho(numeroVizinho, numeroVizinho, nullptr, 0);
+                }
+                custoPorPorta[i] = custo;
+                vizinhoPorPorta[i] = numeroVizinho;
+                if (portaDoVizinho.find(numeroVizinho) == portaDoVizinho.end()) {
+                    portaDoVizinho[numeroVizinho] = i;
+                }
+                primeiraPortaDoVizinho[i] = portaDoVizinho[numeroVizinho];
             }
         }
     }
     
     imprimirTabelaRoteamento("INICIAL - PI");
     
-    // Apenas o nó inicial inicia a propagação de informação
-    if (par("isStarter").boolValue()) {
-        EV << "Nó " << nomeNo << " iniciando propagação de informação (PI) com relógio global..." << endl;
-        simtime_t delayInicial = uniform(0, 0.01);
+    // Estatísticas ao longo do tempo partem da tabela inicial (o próprio nó e os vizinhos)
+    rotasAlcancaveis = 0;
+    somaCustosRotas = 0;
+    alteracoesDaFase = 0;
+    custoContabilizado.assign(tabela.capacidade(), CUSTO_INFINITO);
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        contabilizarRota(destino);
+    }
+    emitirEstadoTabela();
+    
+    carregarCenario();
+    if (tamanhoArea > 0 && dinamico) {
+        throw cRuntimeError("tamanhoArea não é suportado com cenário dinâmico");
+    }
+    
+    // Origens da PI: o nó inicial (isStarter) e, conforme modoPartida, outros nós
+    std::string modoPartida = par("modoPartida").stdstringValue();
+    bool origem = par("isStarter").boolValue();
+    if (modoPartida == "todos") {
+        origem = true;
+    } else if (modoPartida == "fracao") {
+        origem = origem || bernoulli(par("fracaoPartida").doubleValue());
+    } else if (modoPartida == "lista") {
+        std::vector<int> lista = cStringTokenizer(par("listaPartida").stringValue(), " ,").asIntVector();
+        origem = origem || std::find(lista.begin(), lista.end(), meuEndereco) != lista.end();
+    } else if (modoPartida != "unico") {
+        throw cRuntimeError("modoPartida inválido: '%s' (use \"unico\", \"todos\", \"fracao\" ou \"lista\")", modoPartida.c_str());
+    }
+    variasOrigens = (modoPartida != "unico");
+    partidaPendente = origem;
+    reiniciarEco(0);
+    
+    if (origem) {
+        EV_NIVEL(LOG_RESUMO) << "Nó " << nomeNo << " iniciando propagação de informação (PI) com relógio global..." << endl;
+        simtime_t delayInicial = uniform(0, par("janelaPartida").doubleValue());
         scheduleAt(simTime() + delayInicial, new cMessage("IniciarPI"));
     }
+    
+    // Sincronização completa periódica (recupera vizinhos que perderam algum delta)
+    if (intervaloSincronizacao > 0) {
+        temporizadorSincronizacao = new cMessage("SincronizacaoPI");
+        scheduleAt(simTime() + intervaloSincronizacao, temporizadorSincronizacao);
+    }
+    
+    // Plano de dados: começa num instante fixo (possivelmente durante a convergência) ou
+    // quando o aviso de convergência chega (difundirConvergencia)
+    std::string trafego = par("trafego").stdstringValue();
+    if (trafego == "desativado") {
+        modoTrafego = TRAFEGO_DESATIVADO;
+    } else if (trafego == "poisson") {
+        modoTrafego = TRAFEGO_POISSON;
+    } else if (trafego == "cbr") {
+        modoTrafego = TRAFEGO_CBR;
+    } else {
+        throw cRuntimeError("trafego inválido: '%s' (use \"desativado\", \"poisson\" ou \"cbr\")", trafego.c_str());
+    }
+    totalPacotesGerados = 0;
+    totalPacotesEntregues = 0;
+    totalPacotesEncaminhados = 0;
+    totalDescartesSemRota = 0;
+    totalDescartesLaco = 0;
+    totalDescartesEnlace = 0;
+    intervaloPacotes = par("intervaloPacotes").doubleValue();
+    ttlPacotes = par("ttlPacotes").intValue();
+    tamanhoPacote = par("tamanhoPacote").intValue();
+    if (modoTrafego != TRAFEGO_DESATIVADO) {
+        if (intervaloPacotes <= 0 || ttlPacotes <= 0 || tamanhoPacote <= 0) {
+            throw cRuntimeError("Plano de dados exige intervaloPacotes, ttlPacotes e tamanhoPacote positivos");
+        }
+        if (par("duracaoTrafego").doubleValue() < 0) {
+            throw cRuntimeError("duracaoTrafego não pode ser negativa");
+        }
+        
+        // FIB derivada da tabela: daqui em diante acompanha cada rota alterada (registrarAlteracao)
+        std::string formatoFib = par("fib").stdstringValue();
+        if (formatoFib != "plana" && formatoFib != "intervalos") {
+            throw cRuntimeError("fib inválida: '%s' (use \"plana\" ou \"intervalos\")", formatoFib.c_str());
+        }
+        if (gateSize("portas") > TabelaEncaminhamento::MAIOR_PORTA + 1) {
+            throw cRuntimeError("Plano de dados suporta até %d portas por nó", TabelaEncaminhamento::MAIOR_PORTA + 1);
+        }
+        fib.configurar(formatoFib == "plana" ? TabelaEncaminhamento::FORMATO_PLANO : TabelaEncaminhamento::FORMATO_INTERVALOS);
+        // Rotas iniciais: o próprio nó, sem porta, e os vizinhos diretos, pela porta cujo enlace
+        // deu o custo da rota (a mais barata entre enlaces paralelos)
+        for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+             destino = tabela.seguinte(destino)) {
+            int porta = TabelaEncaminhamento::SEM_PORTA;
+            for (int i = 0; i < (int)vizinhoPorPorta.size() && porta == TabelaEncaminhamento::SEM_PORTA; i++) {
+                if (vizinhoPorPorta[i] >= 0 && vizinhoPorPorta[i] == tabela.proximoSalto(destino)
+                    && custoPorPorta[i] == tabela.custo(destino)) {
+                    porta = i;
+                }
+            }
+            atualizarFib(destino, porta);
+        }
+        destinosTrafego = cStringTokenizer(par("destinosTrafego").stringValue(), " ,").asIntVector();
+        destinosTrafego.erase(std::remove(destinosTrafego.begin(), destinosTrafego.end(), meuEndereco), destinosTrafego.end());
+        // Um nó que é o único destino da lista só recebe
+        if (!destinosTrafego.empty() || par("destinosTrafego").stdstringValue().empty()) {
+            temporizadorTrafego = new cMessage("InjetarDados");
+            if (par("inicioTrafego").doubleValue() >= 0) {
+                agendarTrafego(par("inicioTrafego").doubleValue());
+            }
+        }
+    }
 }
 
 void Roteador::handleMessage(cMessage *msg) {
+    // Primeiro evento da simulação: referência para as alocações por evento
+    if (!inicioEventosMarcado) {
+        inicioEventosMarcado = true;
+        eventoInicial = getSimulation()->getEventNumber();
+        alocacoesNoInicio = alocacoesDoProcesso();
+        arenaNoInicio = ArenaClasses::estatisticas();
+        anunciosNoInicio = PoolAnuncios::estatisticas();
+    }
+    
+    // Nó que falhou descarta tudo o que chega (seus temporizadores já foram cancelados)
+    if (falhou) {
+        if (msg->getKind() == MSG_DADOS && !msg->isSelfMessage()) {
+            descartarPacote(check_and_cast<Mensagem *>(msg), DESCARTE_ENLACE);
+        } else {
+            delete msg;
+        }
+        return;
+    }
+    
     // Verifica se é a mensagem para iniciar PI
     if (strcmp(msg->getName(), "IniciarPI") == 0) {
         iniciarPropagacaoInformacao();
@@ -110,50 +347,282 @@ void Roteador::handleMessage(cMessage *msg) {
         return;
     }
     
-    // Processa mensagens de propagação de informação
+    if (msg == temporizadorAgrupamento) {
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " encerrou janela de agrupamento, propagando tabela" << endl;
+        propagarInformacao();
+        verificarConvergencia();
+        return;
+    }
+    
+    if (msg == temporizadorSincronizacao) {
+        sincronizarVizinhos();
+        // Após a convergência não há mais o que sincronizar
+        if (!convergiu) {
+            scheduleAt(simTime() + intervaloSincronizacao, temporizadorSincronizacao);
+        }
+        return;
+    }
+    
+    if (msg == temporizadorCenario) {
+        iniciarEpocaCenario();
+        return;
+    }
+    
+    if (msg == temporizadorTrafego) {
+        injetarPacote();
+        simtime_t proximo = simTime() + (modoTrafego == TRAFEGO_POISSON ? exponential(intervaloPacotes.dbl()) : intervaloPacotes);
+        if (proximo <= fimTrafego) {
+            scheduleAt(proximo, temporizadorTrafego);
+        }
+        return;
+    }
+    
     Mensagem *msgRecebida = check_and_cast<Mensagem *>(msg);
-    registrarMensagemRecebida();
     
-    processarInformacaoRecebida(msgRecebida);
+    // Mensagem que estava em trânsito quando o enlace caiu: o remetente já a descontou
+    if (!portaAtiva[msgRecebida->getArrivalGate()->getIndex()]) {
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " descartou " << msgRecebida->getName()
+           << " recebida por enlace desligado" << endl;
+        if (msgRecebida->getKind() == MSG_DADOS) {
+            descartarPacote(msgRecebida, DESCARTE_ENLACE);
+        } else {
+            delete msgRecebida;
+        }
+        return;
+    }
+    
+    // Pacotes de dados seguem adiante (ou são entregues) sem passar pelo controle
+    if (msgRecebida->getKind() == MSG_DADOS) {
+        encaminharPacote(msgRecebida);
+        return;
+    }
+    
+    switch (msgRecebida->getKind()) {
+        case MSG_PROPAGACAO:
+            // Processa mensagens de propagação de informação; o tempo de parede só é medido
+            // se alguma estatística ouve o sinal
+            registrarMensagemRecebida();
+            if (mayHaveListeners(sinalTempoProcessamento)) {
+                auto inicio = std::chrono::steady_clock::now();
+                processarInformacaoRecebida(msgRecebida);
+                emit(sinalTempoProcessamento,
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+            } else {
+                processarInformacaoRecebida(msgRecebida);
+            }
+            break;
+        case MSG_CONFIRMACAO:
+            processarConfirmacao(msgRecebida);
+            break;
+        case MSG_CONVERGENCIA:
+            difundirConvergencia(msgRecebida->getUltimaAlteracao(), msgRecebida->getArrivalGate()->getIndex());
+            break;
+        case MSG_SONDAGEM:
+            processarSondagem(msgRecebida);
+            break;
+        case MSG_ECO:
+            processarEco(msgRecebida);
+            break;
+        default:
+            throw cRuntimeError("Tipo de mensagem desconhecido: %d", msgRecebida->getKind());
+    }
     delete msgRecebida;
 }
 
 void Roteador::iniciarPropagacaoInformacao() {
-    EV << "Nó " << getFullName() << " iniciando propagação de informação para vizinhos" << endl;
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " iniciando propagação de informação para vizinhos" << endl;
+    
+    // Uma origem livre é a raiz de uma computação difusa; já engajada por outra onda,
+    // apenas anuncia sua tabela como parte dela
+    partidaPendente = false;
+    if (!engajado) {
+        engajado = true;
+        portaPai = -1;
+    }
+    
+    // Com várias origens, o coordenador lança a onda de eco que detecta a terminação global
+    if (variasOrigens && par("isStarter").boolValue() && !sondagemRecebida) {
+        sondagemRecebida = true;
+        portaPaiEco = -1;
+        ecosPendentes = contarPortasAtivas();
+        enviarSondagem(-1);
+    }
+    
     propagarInformacao();
+    verificarConvergencia();
 }
 
 void Roteador::propagarInformacao() {
+    // Este anúncio já inclui as alterações que aguardavam a janela de agrupamento
+    if (temporizadorAgrupamento != nullptr && temporizadorAgrupamento->isScheduled()) {
+        cancelEvent(temporizadorAgrupamento);
+    }
+    
     // Atualiza relógio global baseado no tempo de simulação
     relogioGlobal = simTime();
     faseAtual++;
+    emit(sinalAlteracoesPorFase, alteracoesDaFase);
+    alteracoesDaFase = 0;
     
-    EV << "Nó " << getFullName() << " - Fase " << faseAtual << " - Relógio Global: " << relogioGlobal << endl;
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " - Fase " << faseAtual << " - Relógio Global: " << relogioGlobal << endl;
     
-    // Propaga a tabela de roteamento atual para todos os vizinhos
+    // Propaga a tabela de roteamento atual para todos os vizinhos. O retrato da tabela
+    // é montado uma vez por evento (um completo e, no modo delta, um incremental) e
+    // compartilhado pelas mensagens de todas as portas, sem cópia
+    AnuncioTabelaPtr anuncioCompleto, anuncioDelta;
+    std::vector<int> viaPortaCompleto, viaPortaDelta;
+    std::vector<size_t> bytesViaPortaCompleto, bytesViaPortaDelta;
+    unsigned long versaoBaseDelta = 0;
+    int portasAnunciadas = 0;
     for (int i = 0; i < gateSize("portas"); ++i) {
-        Mensagem *msgPI = new Mensagem("PropagacaoInformacao");
-        msgPI->setIdNoOrigem(extrairNumeroNo(getFullName()));
+        if (!portaAtiva[i]) {
+            continue;
+        }
         
-        // Prepara arrays com informações de roteamento
-        msgPI->setDestinosArraySize(tabelaRoteamento.size());
-        msgPI->setCustosArraySize(tabelaRoteamento.size());
+        // No modo delta, o primeiro anúncio da porta (ou após sincronização) é completo
+        bool completa = !modoDelta || !portaSincronizada[i];
         
-        int j = 0;
-        for (std::map<int, double>::const_iterator it = tabelaRoteamento.begin(); 
-             it != tabelaRoteamento.end(); ++it) {
-            msgPI->setDestinos(j, it->first);
-            msgPI->setCustos(j, it->second);
-            j++;
+        if (completa && !anuncioCompleto) {
+            anuncioCompleto = montarAnuncio(true, 0, viaPortaCompleto, bytesViaPortaCompleto);
+        } else if (!completa && (!anuncioDelta || versaoBaseDelta != versaoAnunciadaPorPorta[i])) {
+            versaoBaseDelta = versaoAnunciadaPorPorta[i];
+            anuncioDelta = montarAnuncio(false, versaoBaseDelta, viaPortaDelta, bytesViaPortaDelta);
+        }
+        const AnuncioTabelaPtr& anuncio = completa ? anuncioCompleto : anuncioDelta;
+        
+        // Horizonte dividido: as rotas que passam pelo vizinho desta porta são filtradas
+        // pelo receptor; aqui só se contabiliza quantas são
+        size_t numEntradas = anuncio->tamanho();
+        size_t bytesEntradas = anuncio->bytesEntradas;
+        if (horizonteDividido != HORIZONTE_DESATIVADO) {
+            int viaVizinho = (completa ? viaPortaCompleto : viaPortaDelta)[primeiraPortaDoVizinho[i]];
+            if (horizonteDividido == HORIZONTE_SIMPLES) {
+                totalEntradasSuprimidas += viaVizinho;
+                numEntradas -= viaVizinho;
+                bytesEntradas -= (completa ? bytesViaPortaCompleto : bytesViaPortaDelta)[primeiraPortaDoVizinho[i]];
+            } else {
+                totalEntradasEnvenenadas += viaVizinho;
+            }
+        }
+        
+        // Hierarquia: o vizinho de outra área só recebe as entradas resumidas das áreas. As
+        // internas vêm no início do retrato e são ignoradas pelo receptor (e nunca passam por
+        // esse vizinho, então não se somam às do horizonte dividido)
+        if (tamanhoArea > 0 && vizinhoPorPorta[i] / tamanhoArea != minhaArea) {
+            totalEntradasResumidas += anuncio->numInternas;
+            numEntradas -= anuncio->numInternas;
+            bytesEntradas -= anuncio->bytesInternas;
+        }
+        
+        versaoAnunciadaPorPorta[i] = versaoTabela;
+        portaSincronizada[i] = true;
+        
+        // Nada mudou desde o último anúncio nesta porta (ou tudo foi suprimido)
+        if (numEntradas == 0) {
+            continue;
+        }
+        
+        Mensagem *msgPI = new Mensagem("PropagacaoInformacao", MSG_PROPAGACAO);
+        msgPI->setIdNoOrigem(meuEndereco);
+        msgPI->setNumeroSequencia(sequenciaPorPorta[i]++);
+        msgPI->setCompleta(completa);
+        msgPI->setAnuncio(anuncio);
+        if (horizonteDividido != HORIZONTE_DESATIVADO) {
+            msgPI->setVizinhoExcluido(vizinhoPorPorta[i]);
+        }
+        msgPI->setByteLength(codificacao.bytesCabecalho(meuEndereco, msgPI->getNumeroSequencia(), numEntradas)
+                             + bytesEntradas);
+        
+        totalEntradasEnviadas += numEntradas;
+        if (completa) {
+            totalAnunciosCompletos++;
+        } else {
+            totalAnunciosDelta++;
         }
         
         // Envia com delay do canal (LINKS COM DELAY)
-        send(msgPI->dup(), "portas$o", i);
+        enviarPelaPorta(msgPI, i);
         registrarMensagemEnviada();
+        deficit++;
+        deficitPorPorta[i]++;
+        portasAnunciadas++;
+    }
+    
+    if (portasAnunciadas > 0) {
+        emit(sinalMensagensEmTransito, deficit);
     }
     
-    EV << "Nó " << getFullName() << " propagou informação de roteamento para " 
-       << gateSize("portas") << " vizinhos na fase " << faseAtual << endl;
+    // Todas as portas estão atualizadas: descarta o registro de alterações já anunciado
+    registroAlteracoes.clear();
+    
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " propagou informação de roteamento para " 
+       << portasAnunciadas << " vizinhos na fase " << faseAtual
+       << (modoDelta ? " (modo delta)" : "") << endl;
+}
+
+AnuncioTabelaPtr Roteador::montarAnuncio(bool completa, unsigned long versaoBase, std::vector<int>& entradasViaPorta,
+                                         std::vector<size_t>& bytesViaPorta) {
+    std::shared_ptr<AnuncioTabela> anuncio = PoolAnuncios::obter();
+    if (completa) {
+        anuncio->destinos.reserve(tabela.tamanho());
+        for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+             destino = tabela.seguinte(destino)) {
+            anuncio->destinos.push_back(destino);
+        }
+    } else {
+        // Apenas destinos alterados após a versão base
+        std::vector<std::pair<unsigned long, int>>::const_iterator it = std::upper_bound(
+            registroAlteracoes.begin(), registroAlteracoes.end(), std::make_pair(versaoBase, INT_MAX));
+        for (; it != registroAlteracoes.end(); ++it) {
+            // Ignora registros antigos de destinos alterados novamente depois
+            if (tabela.versao(it->second) == it->first) {
+                anuncio->destinos.push_back(it->second);
+            }
+        }
+        // A codificação compacta transmite os destinos por diferença, em ordem crescente
+        std::sort(anuncio->destinos.begin(), anuncio->destinos.end());
+    }
+    
+    anuncio->custos.reserve(anuncio->destinos.size());
+    anuncio->proximosSaltos.reserve(anuncio->destinos.size());
+    for (size_t j = 0; j < anuncio->destinos.size(); j++) {
+        anuncio->custos.push_back(codificacao.quantizar(tabela.custo(anuncio->destinos[j])));
+        anuncio->proximosSaltos.push_back(tabela.proximoSalto(anuncio->destinos[j]));
+    }
+    if (vetorCaminho) {
+        anuncio->inicioCaminho.reserve(anuncio->destinos.size() + 1);
+        anuncio->inicioCaminho.push_back(0);
+        for (size_t j = 0; j < anuncio->destinos.size(); j++) {
+            int destino = anuncio->destinos[j];
+            if ((size_t)destino < caminhoPorDestino.size()) {
+                anuncio->nosCaminho.insert(anuncio->nosCaminho.end(), caminhoPorDestino[destino].begin(),
+                                           caminhoPorDestino[destino].end());
+            }
+            anuncio->inicioCaminho.push_back(anuncio->nosCaminho.size());
+        }
+    }
+    anuncio->bytesEntradas = codificacao.bytesEntradas(*anuncio, bytesPorEntrada);
+    if (tamanhoArea > 0) {
+        anuncio->numInternas = std::lower_bound(anuncio->destinos.begin(), anuncio->destinos.end(), tamanhoArea)
+                               - anuncio->destinos.begin();
+        for (size_t j = 0; j < anuncio->numInternas; j++) {
+            anuncio->bytesInternas += bytesPorEntrada[j];
+        }
+    }
+    
+    // Quantas entradas (e bytes) passam pelo vizinho de cada porta (indexado pela primeira porta do vizinho)
+    if (horizonteDividido != HORIZONTE_DESATIVADO) {
+        entradasViaPorta.assign(vizinhoPorPorta.size(), 0);
+        bytesViaPorta.assign(vizinhoPorPorta.size(), 0);
+        for (size_t j = 0; j < anuncio->proximosSaltos.size(); j++) {
+            std::unordered_map<int, int>::const_iterator porta = portaDoVizinho.find(anuncio->proximosSaltos[j]);
+            if (porta != portaDoVizinho.end()) {
+                entradasViaPorta[porta->second]++;
+                bytesViaPorta[porta->second] += bytesPorEntrada[j];
+            }
+        }
+    }
+    return anuncio;
 }
 
 void Roteador::processarInformacaoRecebida(Mensagem *msg) {
@@ -166,133 +635,1180 @@ void Roteador::processarInformacaoRecebida(Mensagem *msg) {
         relogioGlobal = tempoChegada;
     }
     
-    EV << "Nó " << getFullName() << " recebeu mensagem de no" << numeroVizinho 
-       << " no tempo " << tempoChegada << " (Relógio Global: " << relogioGlobal << ")" << endl;
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " recebeu mensagem de no" << numeroVizinho 
+       << " no tempo " << tempoChegada << " (Relógio Global: " << relogioGlobal << ")"
+       << (msg->getCompleta() ? " [completa]" : " [delta]") << endl;
     
-    // Reconstrói a tabela do vizinho
-    std::map<int, double> tabelaVizinho;
-    for (unsigned int i = 0; i < msg->getDestinosArraySize(); i++) {
-        tabelaVizinho[msg->getDestinos(i)] = msg->getCustos(i);
+    // Controle de sequência por porta: um delta fora de ordem indica anúncio perdido
+    int porta = msg->getArrivalGate()->getIndex();
+    if (!msg->getCompleta() && msg->getNumeroSequencia() != sequenciaRecebidaPorPorta[porta] + 1) {
+        totalLacunasSequencia++;
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " detectou lacuna de sequência na porta " << porta
+           << " (esperado " << sequenciaRecebidaPorPorta[porta] + 1
+           << ", recebido " << msg->getNumeroSequencia() << ")" << endl;
     }
+    sequenciaRecebidaPorPorta[porta] = msg->getNumeroSequencia();
     
-    double custoAteVizinho = custoVizinhos[numeroVizinho];
+    // Dijkstra-Scholten: a mensagem que engaja o nó torna o remetente seu pai;
+    // as demais são confirmadas imediatamente
+    if (!engajado) {
+        engajado = true;
+        portaPai = porta;
+    } else {
+        enviarConfirmacao(porta, SIMTIME_ZERO);
+    }
     
-    // Processa informações recebidas usando conceito de PI
-    for (std::map<int, double>::const_iterator it = tabelaVizinho.begin(); 
-         it != tabelaVizinho.end(); ++it) {
-        int destino = it->first;
-        double custoDoVizinho = it->second;
-        double novoCusto = custoAteVizinho + custoDoVizinho;
+    // Processa informações recebidas usando conceito de PI: relaxa direto sobre o retrato
+    // compartilhado, ignorando as rotas que o vizinho aprendeu por este nó (horizonte dividido)
+    // e, se ele é de outra área, as rotas internas da área dele
+    const AnuncioTabela& anuncio = *msg->getAnuncio();
+    destinosAlterados.clear();
+    if (dinamico) {
+        aplicarAnuncioDinamico(anuncio, porta, numeroVizinho, msg->getVizinhoExcluido());
+    } else {
+        size_t inicio = 0;
+        if (tamanhoArea > 0 && numeroVizinho / tamanhoArea != minhaArea) {
+            inicio = std::lower_bound(anuncio.destinos.begin(), anuncio.destinos.end(), tamanhoArea)
+                     - anuncio.destinos.begin();
+        }
+        tabela.relaxar(anuncio.destinos.data() + inicio, anuncio.custos.data() + inicio, anuncio.tamanho() - inicio,
+                       custoPorPorta[porta], numeroVizinho, destinosAlterados,
+                       msg->getVizinhoExcluido() >= 0 ? anuncio.proximosSaltos.data() + inicio : nullptr,
+                       msg->getVizinhoExcluido());
+        for (size_t i = 0; i < destinosAlterados.size(); i++) {
+            atualizarFib(destinosAlterados[i], porta);
+        }
         
-        // Atualiza se encontrou caminho melhor ou destino novo
-        if (tabelaRoteamento.find(destino) == tabelaRoteamento.end() || 
-            novoCusto < tabelaRoteamento[destino]) {
-            
-            EV << "Nó " << getFullName() << " atualizou rota para no" << destino 
-               << " via no" << numeroVizinho << " (custo: " << novoCusto << ") na fase " << faseAtual << endl;
-            
-            tabelaRoteamento[destino] = novoCusto;
-            proximosSaltos[destino] = numeroVizinho;
-            tabelaAtualizada = true;
-            
-            // Adiciona destino à lista se for novo
-            bool encontrado = false;
-            for (size_t k = 0; k < destinosConhecidos.size(); k++) {
-                if (destinosConhecidos[k] == destino) {
-                    encontrado = true;
-                    break;
-                }
-            }
-            if (!encontrado) {
-                destinosConhecidos.push_back(destino);
+        // Sem cenário dinâmico as rotas só melhoram estritamente e os custos não são negativos,
+        // então nenhum caminho que passe por este nó é adotado: basta copiar os caminhos novos
+        if (vetorCaminho && anuncio.temCaminhos()) {
+            for (size_t i = 0; i < destinosAlterados.size(); i++) {
+                int destino = destinosAlterados[i];
+                size_t j = std::lower_bound(anuncio.destinos.begin(), anuncio.destinos.end(), destino)
+                           - anuncio.destinos.begin();
+                atribuirCaminho(destino, numeroVizinho, anuncio.nosCaminho.data() + anuncio.inicioCaminho[j],
+                                anuncio.inicioCaminho[j + 1] - anuncio.inicioCaminho[j]);
             }
         }
     }
     
-    // Se a tabela foi atualizada, propaga a nova informação
+    for (size_t i = 0; i < destinosAlterados.size(); i++) {
+        int destino = destinosAlterados[i];
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " atualizou rota para " << nomeDestino(destino)
+           << " via no" << tabela.proximoSalto(destino) << " (custo: " << tabela.custo(destino) << ") na fase " << faseAtual << endl;
+        registrarAlteracao(destino);
+        tabelaAtualizada = true;
+    }
+    
+    // Se a tabela foi atualizada, propaga a nova informação. Na primeira mensagem
+    // recebida o nó propaga mesmo sem melhoria, para a onda PI alcançar toda a rede
     if (tabelaAtualizada) {
+        emitirEstadoTabela();
         imprimirTabelaRoteamento("Após PI");
+    }
+    if (tabelaAtualizada || faseAtual == 0) {
+        agendarPropagacao();
+    }
+    
+    verificarConvergencia();
+}
+
+void Roteador::agendarPropagacao() {
+    if (janelaAgrupamento <= 0) {
+        propagarInformacao();
+        return;
+    }
+    
+    // Já existe propagação pendente: esta atualização segue no mesmo anúncio
+    if (temporizadorAgrupamento->isScheduled()) {
+        totalAtualizacoesAgrupadas++;
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " agrupou atualização no anúncio pendente ("
+           << totalAtualizacoesAgrupadas << " agrupadas)" << endl;
+        return;
+    }
+    
+    scheduleAt(simTime() + janelaAgrupamento, temporizadorAgrupamento);
+}
+
+void Roteador::registrarAlteracao(int destino) {
+    ultimaAlteracaoLocal = simTime();
+    if ((size_t)destino >= instanteAlteracaoPorDestino.size()) {
+        instanteAlteracaoPorDestino.resize(tabela.capacidade(), SIMTIME_ZERO);
+    }
+    instanteAlteracaoPorDestino[destino] = simTime();
+    contabilizarRota(destino);
+    alteracoesDaFase++;
+    ultimaAlteracaoSubarvore = simTime();
+    versaoTabela++;
+    tabela.definirVersao(destino, versaoTabela);
+    if (modoDelta) {
+        registroAlteracoes.push_back(std::make_pair(versaoTabela, destino));
+    }
+}
+
+void Roteador::contabilizarRota(int destino) {
+    // Troca a parcela antiga do destino pela atual; só custos finitos contam
+    if ((size_t)destino >= custoContabilizado.size()) {
+        custoContabilizado.resize(tabela.capacidade(), CUSTO_INFINITO);
+    }
+    double anterior = custoContabilizado[destino];
+    double atual = tabela.custo(destino);
+    if (anterior < CUSTO_INFINITO) {
+        rotasAlcancaveis--;
+        somaCustosRotas -= anterior;
+    }
+    if (atual < CUSTO_INFINITO) {
+        rotasAlcancaveis++;
+        somaCustosRotas += atual;
+    }
+    custoContabilizado[destino] = atual;
+}
+
+void Roteador::emitirEstadoTabela() {
+    emit(sinalRotasConhecidas, rotasAlcancaveis);
+    emit(sinalSomaCustos, somaCustosRotas);
+}
+
+void Roteador::sincronizarVizinhos() {
+    // Só sincroniza enquanto participa da computação (não inicia ondas por conta própria)
+    // e se a tabela mudou desde a última sincronização; do contrário a sincronização
+    // manteria a computação difusa ativa indefinidamente
+    if (!engajado || versaoTabela == versaoSincronizada) {
+        return;
+    }
+    versaoSincronizada = versaoTabela;
+    
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " enviando sincronização completa para os vizinhos" << endl;
+    portaSincronizada.assign(portaSincronizada.size(), false);
+    propagarInformacao();
+}
+
+// Dijkstra-Scholten (RoteadorBase): o nó só está ocioso sem anúncio agrupado pendente
+bool Roteador::ocioso() const {
+    return temporizadorAgrupamento == nullptr || !temporizadorAgrupamento->isScheduled();
+}
+
+void Roteador::confirmacaoContada(int porta) {
+    deficitPorPorta[porta]--;
+    emit(sinalMensagensEmTransito, deficit);
+}
+
+void Roteador::raizLiberada() {
+    if (!variasOrigens && epocaAtual == 0) {
+        RoteadorBase::raizLiberada();
+        return;
+    }
+    // Só a árvore desta raiz se desfez; outras ainda podem estar ativas
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " teve sua árvore de propagação desfeita (última alteração em "
+       << ultimaAlteracaoSubarvore << "s)" << endl;
+    if (ultimaAlteracaoSubarvore > ultimaAlteracaoEco) {
+        ultimaAlteracaoEco = ultimaAlteracaoSubarvore;
+    }
+}
+
+void Roteador::computacaoDeixada() {
+    verificarEco();
+}
+
+void Roteador::enviarSondagem(int portaOrigem) {
+    for (int i = 0; i < gateSize("portas"); ++i) {
+        if (i == portaOrigem || !portaAtiva[i]) {
+            continue;
+        }
+        Mensagem *sondagem = new Mensagem("Sondagem", MSG_SONDAGEM);
+        sondagem->setIdNoOrigem(meuEndereco);
+        sondagem->setEpoca(epocaEco);
+        sondagem->setByteLength(codificacao.bytesControle(meuEndereco));
+        enviarPelaPorta(sondagem, i);
+        totalMensagensControle++;
+    }
+}
+
+void Roteador::processarSondagem(Mensagem *msg) {
+    // Sondagens de uma época já encerrada neste nó são ignoradas
+    if (msg->getEpoca() < epocaEco) {
+        return;
+    }
+    if (msg->getEpoca() > epocaEco) {
+        reiniciarEco(msg->getEpoca());
+    }
+    
+    int porta = msg->getArrivalGate()->getIndex();
+    if (!sondagemRecebida) {
+        // A primeira sondagem define o pai na onda de eco e segue para as demais portas
+        sondagemRecebida = true;
+        portaPaiEco = porta;
+        ecosPendentes = contarPortasAtivas() - 1;
+        enviarSondagem(porta);
+    } else {
+        // Sondagem cruzada: vale como resposta desta porta
+        ecosPendentes--;
+    }
+    verificarEco();
+}
+
+void Roteador::processarEco(Mensagem *msg) {
+    if (msg->getEpoca() != epocaEco) {
+        return;
+    }
+    ecosPendentes--;
+    if (msg->getUltimaAlteracao() > ultimaAlteracaoEco) {
+        ultimaAlteracaoEco = msg->getUltimaAlteracao();
+    }
+    anunciosEco += msg->getAnunciosEpoca();
+    verificarEco();
+}
+
+void Roteador::reiniciarEco(int epoca) {
+    epocaEco = epoca;
+    sondagemRecebida = false;
+    ecoEnviado = false;
+    portaPaiEco = -1;
+    ecosPendentes = 0;
+    ultimaAlteracaoEco = SIMTIME_ZERO;
+    anunciosEco = 0;
+}
+
+int Roteador::contarPortasAtivas() {
+    return (int)std::count(portaAtiva.begin(), portaAtiva.end(), true);
+}
+
+void Roteador::verificarEco() {
+    // O eco só retorna por um nó livre, que já partiu (se for origem) e ouviu todas as
+    // portas. Como só origens criam árvores e cada uma parte uma vez, um nó que ecoou e
+    // volta a ser engajado pertence a uma árvore cuja raiz ainda não ecoou
+    if (!sondagemRecebida || ecoEnviado || ecosPendentes > 0 || engajado || partidaPendente) {
+        return;
+    }
+    ecoEnviado = true;
+    
+    simtime_t ultimaAlteracao = ultimaAlteracaoEco;
+    if (ultimaAlteracaoLocal > ultimaAlteracao) {
+        ultimaAlteracao = ultimaAlteracaoLocal;
+    }
+    int anuncios = anunciosEco + totalMensagensEnviadas - anunciosInicioEpoca;
+    if (portaPaiEco == -1 && epocaEco == 0) {
+        EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " detectou a terminação de todas as ondas (última alteração em "
+           << ultimaAlteracao << "s)" << endl;
+        difundirConvergencia(ultimaAlteracao, -1);
+        return;
+    }
+    if (portaPaiEco == -1) {
+        // Reconvergência da época: da ocorrência dos eventos à última alteração de tabela
+        simtime_t instanteEventos = instantesCenario[epocaEco - 1];
+        simtime_t reconvergencia = ultimaAlteracao > instanteEventos ? ultimaAlteracao - instanteEventos : SIMTIME_ZERO;
+        EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " detectou a reconvergência da época " << epocaEco << " em "
+           << reconvergencia << "s (" << anuncios << " anúncios)" << endl;
+        vetorReconvergencia.recordWithTimestamp(instanteEventos, reconvergencia.dbl());
+        vetorAnunciosEpoca.recordWithTimestamp(instanteEventos, anuncios);
+        epocasReconvergidas++;
+        return;
+    }
+    
+    Mensagem *eco = new Mensagem("Eco", MSG_ECO);
+    eco->setIdNoOrigem(meuEndereco);
+    eco->setEpoca(epocaEco);
+    eco->setAnunciosEpoca(anuncios);
+    eco->setUltimaAlteracao(ultimaAlteracao);
+    eco->setByteLength(codificacao.bytesControle(meuEndereco));
+    enviarPelaPorta(eco, portaPaiEco);
+    totalMensagensControle++;
+}
+
+// Primeiro aviso de convergência: confere a tabela e, se configurado, inicia o tráfego
+void Roteador::aoConvergir() {
+    verificarConsistenciaRoteamento();
+    
+    if (temporizadorTrafego != nullptr && par("inicioTrafego").doubleValue() < 0) {
+        agendarTrafego(simTime());
+    }
+}
+
+// O primeiro pacote sai depois de um intervalo sorteado (no CBR, uma fase em
+// [0, intervaloPacotes), para os nós não injetarem todos no mesmo instante)
+void Roteador::agendarTrafego(simtime_t inicio) {
+    fimTrafego = inicio + par("duracaoTrafego").doubleValue();
+    simtime_t primeiro = inicio + (modoTrafego == TRAFEGO_POISSON ? exponential(intervaloPacotes.dbl())
+                                                                  : uniform(0, intervaloPacotes.dbl()));
+    if (primeiro <= fimTrafego) {
+        scheduleAt(primeiro, temporizadorTrafego);
+    }
+}
+
+void Roteador::injetarPacote() {
+    int destino = sortearDestino();
+    if (destino < 0) {
+        return;
+    }
+    Mensagem *pacote = new Mensagem("Dados", MSG_DADOS);
+    pacote->setIdNoOrigem(meuEndereco);
+    pacote->setDestino(destino);
+    pacote->setByteLength(tamanhoPacote);
+    totalPacotesGerados++;
+    encaminharPacote(pacote);
+}
+
+// Destino uniforme entre os configurados ou, sem lista, entre os demais nós da rede
+// (coletados uma vez por execução, no primeiro sorteio)
+int Roteador::sortearDestino() {
+    if (!destinosTrafego.empty()) {
+        return destinosTrafego[intuniform(0, destinosTrafego.size() - 1)];
+    }
+    if (!enderecosColetados) {
+        std::vector<Roteador *> roteadores;
+        if (!coletarRoteadores(roteadores)) {
+            throw cRuntimeError("Em simulação particionada o plano de dados exige a lista destinosTrafego");
+        }
+        enderecosRede.clear();
+        for (size_t i = 0; i < roteadores.size(); i++) {
+            enderecosRede.push_back(roteadores[i]->meuEndereco);
+        }
+        enderecosColetados = true;
+    }
+    if (enderecosRede.size() < 2) {
+        return -1;
+    }
+    int destino;
+    do {
+        destino = enderecosRede[intuniform(0, enderecosRede.size() - 1)];
+    } while (destino == meuEndereco);
+    return destino;
+}
+
+// Porta escolhida pela decisão de roteamento que definiu a rota (SEM_PORTA: o próprio nó ou
+// sem rota). Com enlaces paralelos até o próximo salto, é a porta cujo enlace deu o custo,
+// e não a primeira até o vizinho, que pode estar desligada
+void Roteador::atualizarFib(int destino, int porta) {
+    if (modoTrafego != TRAFEGO_DESATIVADO) {
+        fib.definir(destino, porta);
+    }
+}
+
+// Entrega o pacote ou o envia pela porta da FIB, que segue o próximo salto atual da tabela;
+// com hierarquia, segue a entrada resumida da área do destino até entrar nela. Durante a
+// reconvergência a tabela pode estar sem rota ou formar laços, que o ttlPacotes limita
+void Roteador::encaminharPacote(Mensagem *pacote) {
+    marcarParedeDados();
+    int destino = pacote->getDestino();
+    if (destino == meuEndereco) {
+        totalPacotesEntregues++;
+        emit(sinalAtrasoPacote, simTime() - pacote->getCreationTime());
+        emit(sinalSaltosPacote, pacote->getSaltos());
+        delete pacote;
+        return;
+    }
+    if (pacote->getSaltos() >= ttlPacotes) {
+        descartarPacote(pacote, DESCARTE_LACO);
+        return;
+    }
+    int porta = fib.porta(indiceDestino(destino));
+    if (porta == TabelaEncaminhamento::SEM_PORTA || !portaAtiva[porta]) {
+        descartarPacote(pacote, DESCARTE_SEM_ROTA);
+        return;
+    }
+    pacote->setSaltos(pacote->getSaltos() + 1);
+    totalPacotesEncaminhados++;
+    transmitir(pacote, porta);
+}
+
+void Roteador::descartarPacote(Mensagem *pacote, MotivoDescarte motivo) {
+    marcarParedeDados();
+    const char *descricao;
+    switch (motivo) {
+        case DESCARTE_SEM_ROTA:
+            totalDescartesSemRota++;
+            descricao = "sem rota";
+            break;
+        case DESCARTE_LACO:
+            totalDescartesLaco++;
+            descricao = "ttl esgotado (laço)";
+            break;
+        default:
+            totalDescartesEnlace++;
+            descricao = "enlace caído";
+            break;
+    }
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " descartou pacote de no" << pacote->getIdNoOrigem()
+       << " para no" << pacote->getDestino() << " após " << pacote->getSaltos() << " saltos: " << descricao << endl;
+    emit(sinalPacoteDescartado, (long)motivo);
+    delete pacote;
+}
+
+// Tempo de parede do primeiro ao último evento de dados do processo
+void Roteador::marcarParedeDados() {
+    fimParedeDados = std::chrono::steady_clock::now();
+    if (!paredeDadosMarcada) {
+        paredeDadosMarcada = true;
+        inicioParedeDados = fimParedeDados;
+    }
+}
+
+void Roteador::carregarCenario() {
+    dinamico = false;
+    custoMaximo = par("custoMaximo").doubleValue();
+    proximoEventoCenario = 0;
+    epocaAtual = 0;
+    anunciosInicioEpoca = 0;
+    falhou = false;
+    epocasReconvergidas = 0;
+    
+    cXMLElement *cenario = par("cenario").xmlValue();
+    std::vector<cXMLElement *> elementos = cenario->getChildrenByTagName("evento");
+    if (elementos.empty()) {
+        return;
+    }
+    dinamico = true;
+    if (custoMaximo <= 0) {
+        throw cRuntimeError("Cenário dinâmico exige custoMaximo > 0 (limite da contagem ao infinito)");
+    }
+    if (horizonteDividido == HORIZONTE_SIMPLES) {
+        // Sem temporizadores de expiração, a rota omitida nunca é retirada do vizinho
+        throw cRuntimeError("Cenário dinâmico exige horizonteDividido \"desativado\" ou \"reversoEnvenenado\"");
+    }
+    
+    // Eventos em ordem de instante (no mesmo instante, na ordem do arquivo)
+    std::vector<std::pair<simtime_t, size_t>> ordem;
+    for (size_t i = 0; i < elementos.size(); i++) {
+        ordem.push_back(std::make_pair(SimTime::parse(atributoEvento(elementos[i], "t")), i));
+    }
+    std::sort(ordem.begin(), ordem.end());
+    
+    // Cada nó lê o cenário inteiro, mas guarda apenas os eventos das suas portas; todos
+    // conhecem os instantes, que delimitam as épocas medidas pelo coordenador
+    std::vector<int> nosFalhos;
+    for (size_t i = 0; i < ordem.size(); i++) {
+        cXMLElement *elemento = elementos[ordem[i].second];
+        if (ordem[i].first <= simTime()) {
+            throw cRuntimeError("Evento do cenário deve ocorrer depois do início da simulação (%s)", elemento->getSourceLocation());
+        }
+        if (instantesCenario.empty() || instantesCenario.back() != ordem[i].first) {
+            instantesCenario.push_back(ordem[i].first);
+        }
+        EventoCenario evento;
+        evento.epoca = instantesCenario.size();
+        evento.atraso = 0;
+        
+        std::string tipo = atributoEvento(elemento, "tipo");
+        if (tipo == "falha") {
+            int no = atoi(atributoEvento(elemento, "no"));
+            if (no == meuEndereco && par("isStarter").boolValue()) {
+                throw cRuntimeError("O nó coordenador (isStarter) não pode falhar no cenário");
+            }
+            nosFalhos.push_back(no);
+            // Para os vizinhos, a falha é a queda dos enlaces até o nó
+            evento.tipo = no == meuEndereco ? EVENTO_FALHA : EVENTO_DESLIGAR;
+            for (int porta = 0; porta < (int)vizinhoPorPorta.size(); porta++) {
+                if (no == meuEndereco || vizinhoPorPorta[porta] == no) {
+                    evento.porta = no == meuEndereco ? -1 : porta;
+                    eventosCenario.push_back(evento);
+                    if (no == meuEndereco) {
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
+        
+        if (tipo == "atraso") {
+            evento.tipo = EVENTO_ATRASO;
+            evento.atraso = SimTime::parse(atributoEvento(elemento, "atraso")).dbl();
+        } else if (tipo == "desligar") {
+            evento.tipo = EVENTO_DESLIGAR;
+        } else if (tipo == "ligar") {
+            evento.tipo = EVENTO_LIGAR;
+        } else {
+            throw cRuntimeError("Tipo de evento inválido: '%s' (use \"atraso\", \"desligar\", \"ligar\" ou \"falha\")", tipo.c_str());
+        }
+        int no = atoi(atributoEvento(elemento, "no"));
+        int vizinho = atoi(atributoEvento(elemento, "vizinho"));
+        if (std::find(nosFalhos.begin(), nosFalhos.end(), no) != nosFalhos.end()
+            || std::find(nosFalhos.begin(), nosFalhos.end(), vizinho) != nosFalhos.end()) {
+            throw cRuntimeError("Evento '%s' em enlace de nó que já falhou (no%d-no%d)", tipo.c_str(), no, vizinho);
+        }
+        int outraPonta = no == meuEndereco ? vizinho : (vizinho == meuEndereco ? no : -1);
+        if (outraPonta < 0) {
+            continue;
+        }
+        // Sem o atributo porta, o evento vale para todos os enlaces paralelos entre os dois nós;
+        // com ele, só para o enlace que sai pela porta de índice dado em "no"
+        const char *atributoPorta = elemento->getAttribute("porta");
+        int portaNo = atributoPorta != nullptr ? atoi(atributoPorta) : -1;
+        bool encontrado = false;
+        for (int porta = 0; porta < (int)vizinhoPorPorta.size(); porta++) {
+            if (vizinhoPorPorta[porta] != outraPonta) {
+                continue;
+            }
+            if (portaNo >= 0) {
+                int portaEmNo = no == meuEndereco ? porta : gate("portas$o", porta)->getPathEndGate()->getIndex();
+                if (portaEmNo != portaNo) {
+                    continue;
+                }
+            }
+            evento.porta = porta;
+            eventosCenario.push_back(evento);
+            encontrado = true;
+        }
+        if (!encontrado) {
+            throw cRuntimeError("Evento '%s' em enlace inexistente: no%d-no%d", tipo.c_str(), meuEndereco, outraPonta);
+        }
+    }
+    
+    // Adj-RIB-In: cada vizinho alcança a si mesmo com custo zero
+    custosAnunciadosPorPorta.assign(vizinhoPorPorta.size(), std::vector<double>());
+    caminhosAnunciadosPorPorta.assign(vetorCaminho ? vizinhoPorPorta.size() : 0, std::vector<std::vector<int>>());
+    for (int porta = 0; porta < (int)vizinhoPorPorta.size(); porta++) {
+        if (vizinhoPorPorta[porta] >= 0) {
+            anotarAnuncio(porta, vizinhoPorPorta[porta], 0.0);
+        }
+    }
+    
+    vetorReconvergencia.setName("tempo_reconvergencia");
+    vetorAnunciosEpoca.setName("anuncios_por_evento");
+    temporizadorCenario = new cMessage("EventoCenario");
+    scheduleAt(instantesCenario[0], temporizadorCenario);
+}
+
+void Roteador::iniciarEpocaCenario() {
+    epocaAtual++;
+    anunciosInicioEpoca = totalMensagensEnviadas;
+    if (epocaEco < epocaAtual) {
+        reiniciarEco(epocaAtual);
+    }
+    if (epocaAtual < (int)instantesCenario.size()) {
+        scheduleAt(instantesCenario[epocaAtual], temporizadorCenario);
+    }
+    
+    // Aplica os eventos da época que afetam este nó
+    destinosAlterados.clear();
+    bool religou = false;
+    while (proximoEventoCenario < eventosCenario.size() && eventosCenario[proximoEventoCenario].epoca == epocaAtual) {
+        const EventoCenario& evento = eventosCenario[proximoEventoCenario++];
+        switch (evento.tipo) {
+            case EVENTO_ATRASO:
+                alterarAtrasoPorta(evento.porta, evento.atraso);
+                break;
+            case EVENTO_DESLIGAR:
+                desligarPorta(evento.porta);
+                break;
+            case EVENTO_LIGAR:
+                religou = religou || !portaAtiva[evento.porta];
+                ligarPorta(evento.porta);
+                break;
+            case EVENTO_FALHA:
+                falharNo();
+                return;
+        }
+    }
+    
+    // Um nó afetado é raiz de uma nova computação difusa (ou a estende, se já engajado)
+    for (size_t i = 0; i < destinosAlterados.size(); i++) {
+        registrarAlteracao(destinosAlterados[i]);
+    }
+    if (!destinosAlterados.empty() || religou) {
+        if (!engajado) {
+            engajado = true;
+            portaPai = -1;
+        }
+        emitirEstadoTabela();
+        imprimirTabelaRoteamento("Após evento do cenário");
         propagarInformacao();
     }
     
+    // O coordenador mede a reconvergência da época com uma onda de eco
+    if (par("isStarter").boolValue()) {
+        sondagemRecebida = true;
+        portaPaiEco = -1;
+        ecosPendentes = contarPortasAtivas();
+        enviarSondagem(-1);
+    }
     verificarConvergencia();
+    verificarEco();
+}
+
+void Roteador::desligarPorta(int porta) {
+    if (!portaAtiva[porta]) {
+        return;
+    }
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " perdeu o enlace com no" << vizinhoPorPorta[porta] << endl;
+    portaAtiva[porta] = false;
+    gate("portas$o", porta)->getChannel()->par("disabled").setBoolValue(true);
+    
+    // Anúncios enviados por esta porta não serão confirmados; se o pai estava do outro
+    // lado, o nó passa a ser raiz do que resta da sua computação
+    deficit -= deficitPorPorta[porta];
+    deficitPorPorta[porta] = 0;
+    emit(sinalMensagensEmTransito, deficit);
+    if (engajado && portaPai == porta) {
+        portaPai = -1;
+    }
+    
+    custosAnunciadosPorPorta[porta].clear();
+    if (vetorCaminho) {
+        caminhosAnunciadosPorPorta[porta].clear();
+    }
+    recalcularRotasVia(vizinhoPorPorta[porta]);
 }
 
-void Roteador::verificarConvergencia() {
-    // Verifica se convergiu (todos os nós conhecem todos os destinos)
-    int totalNos = 8; // Para todas as topologias implementadas
+void Roteador::ligarPorta(int porta) {
+    if (portaAtiva[porta]) {
+        return;
+    }
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " restabeleceu o enlace com no" << vizinhoPorPorta[porta] << endl;
+    portaAtiva[porta] = true;
+    gate("portas$o", porta)->getChannel()->par("disabled").setBoolValue(false);
     
-    if (tabelaRoteamento.size() >= totalNos && !convergiu) {
-        convergiu = true;
-        tempoConvergencia = simTime() - tempoInicial;
-        EV << "Nó " << getFullName() << " CONVERGIU em " << tempoConvergencia << "s" << endl;
+    // O vizinho recebe a tabela completa; as rotas por ele voltam com o anúncio dele
+    portaSincronizada[porta] = false;
+    custosAnunciadosPorPorta[porta].clear();
+    if (vetorCaminho) {
+        caminhosAnunciadosPorPorta[porta].clear();
+    }
+    anotarAnuncio(porta, vizinhoPorPorta[porta], 0.0);
+    if (recalcularRota(vizinhoPorPorta[porta])) {
+        destinosAlterados.push_back(vizinhoPorPorta[porta]);
+    }
+}
+
+void Roteador::alterarAtrasoPorta(int porta, double atraso) {
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " alterou o atraso do enlace com no" << vizinhoPorPorta[porta]
+       << " de " << custoPorPorta[porta] << "s para " << atraso << "s" << endl;
+    custoPorPorta[porta] = atraso;
+    gate("portas$o", porta)->getChannel()->par("delay").setDoubleValue(atraso);
+    if (!portaAtiva[porta]) {
+        return;
+    }
+    
+    // Rotas por este vizinho podem piorar; as demais podem melhorar passando por ele
+    const std::vector<double>& anunciados = custosAnunciadosPorPorta[porta];
+    int vizinho = vizinhoPorPorta[porta];
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        bool viaPorta = (size_t)destino < anunciados.size() && atraso + anunciados[destino] < tabela.custo(destino);
+        if ((tabela.proximoSalto(destino) == vizinho || viaPorta) && recalcularRota(destino)) {
+            destinosAlterados.push_back(destino);
+        }
+    }
+}
+
+void Roteador::falharNo() {
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " FALHOU" << endl;
+    falhou = true;
+    engajado = false;
+    deficit = 0;
+    emit(sinalMensagensEmTransito, deficit);
+    if (temporizadorAgrupamento != nullptr) {
+        cancelEvent(temporizadorAgrupamento);
+    }
+    if (temporizadorSincronizacao != nullptr) {
+        cancelEvent(temporizadorSincronizacao);
+    }
+    cancelEvent(temporizadorCenario);
+    if (temporizadorTrafego != nullptr) {
+        cancelEvent(temporizadorTrafego);
+    }
+    for (int porta = 0; porta < (int)portaAtiva.size(); porta++) {
+        if (portaAtiva[porta] && gate("portas$o", porta)->getChannel() != nullptr) {
+            gate("portas$o", porta)->getChannel()->par("disabled").setBoolValue(true);
+        }
+        portaAtiva[porta] = false;
+    }
+}
+
+void Roteador::aplicarAnuncioDinamico(const AnuncioTabela& anuncio, int porta, int numeroVizinho, int vizinhoExcluido) {
+    // Guarda o anúncio (Adj-RIB-In) e reavalia cada destino anunciado: a rota que passa
+    // pelo remetente pode piorar, e então é recalculada entre todas as portas; as demais
+    // só podem melhorar. Custos a partir de custoMaximo contam como inalcançáveis, assim
+    // como, no vetor de caminho, as entradas cujo caminho já passa por este nó
+    double custoAteVizinho = custoPorPorta[porta];
+    bool comCaminhos = vetorCaminho && anuncio.temCaminhos();
+    for (size_t i = 0; i < anuncio.tamanho(); i++) {
+        int destino = anuncio.destinos[i];
+        double custo = anuncio.custos[i];
+        if (vizinhoExcluido >= 0 && anuncio.proximosSaltos[i] == vizinhoExcluido) {
+            custo = CUSTO_INFINITO;
+        }
+        const int *caminho = nullptr;
+        size_t tamanhoCaminho = 0;
+        if (comCaminhos) {
+            if (custo < CUSTO_INFINITO && anuncio.caminhoContem(i, meuEndereco)) {
+                totalCaminhosRejeitados++;
+                custo = CUSTO_INFINITO;
+            } else {
+                caminho = anuncio.nosCaminho.data() + anuncio.inicioCaminho[i];
+                tamanhoCaminho = anuncio.inicioCaminho[i + 1] - anuncio.inicioCaminho[i];
+            }
+        }
+        anotarAnuncio(porta, destino, custo, caminho, tamanhoCaminho);
         
-        verificarConsistenciaRoteamento();
+        if (tabela.proximoSalto(destino) == numeroVizinho) {
+            if (recalcularRota(destino)) {
+                destinosAlterados.push_back(destino);
+            }
+        } else if (custoAteVizinho + custo < tabela.custo(destino) && custoAteVizinho + custo < custoMaximo) {
+            tabela.definir(destino, custoAteVizinho + custo, numeroVizinho);
+            atualizarFib(destino, porta);
+            if (comCaminhos) {
+                atribuirCaminho(destino, numeroVizinho, caminho, tamanhoCaminho);
+            }
+            destinosAlterados.push_back(destino);
+        }
+    }
+}
+
+void Roteador::anotarAnuncio(int porta, int destino, double custo, const int *caminho, size_t tamanhoCaminho) {
+    std::vector<double>& anunciados = custosAnunciadosPorPorta[porta];
+    if ((size_t)destino >= anunciados.size()) {
+        anunciados.resize(std::max((size_t)destino + 1, tabela.capacidade()), CUSTO_INFINITO);
+    }
+    anunciados[destino] = custo;
+    if (vetorCaminho) {
+        std::vector<std::vector<int>>& caminhos = caminhosAnunciadosPorPorta[porta];
+        if (caminhos.size() < anunciados.size()) {
+            caminhos.resize(anunciados.size());
+        }
+        caminhos[destino].assign(caminho, caminho + tamanhoCaminho);
+    }
+}
+
+void Roteador::atribuirCaminho(int destino, int vizinho, const int *nos, size_t numNos) {
+    if ((size_t)destino >= caminhoPorDestino.size()) {
+        caminhoPorDestino.resize(std::max((size_t)destino + 1, tabela.capacidade()));
+    }
+    std::vector<int>& caminho = caminhoPorDestino[destino];
+    caminho.assign(1, vizinho);
+    caminho.insert(caminho.end(), nos, nos + numNos);
+}
+
+bool Roteador::recalcularRota(int destino) {
+    if (destino == meuEndereco) {
+        return false;
+    }
+    
+    // Melhor porta ativa pelo último anúncio de cada vizinho; em empate, mantém o salto atual
+    double melhorCusto = CUSTO_INFINITO;
+    int melhorSalto = TabelaRoteamento::SEM_ROTA;
+    int melhorPorta = -1;
+    for (size_t porta = 0; porta < custosAnunciadosPorPorta.size(); porta++) {
+        const std::vector<double>& anunciados = custosAnunciadosPorPorta[porta];
+        if (!portaAtiva[porta] || (size_t)destino >= anunciados.size()) {
+            continue;
+        }
+        double custo = custoPorPorta[porta] + anunciados[destino];
+        if (custo < melhorCusto || (custo == melhorCusto && vizinhoPorPorta[porta] == tabela.proximoSalto(destino))) {
+            melhorCusto = custo;
+            melhorSalto = vizinhoPorPorta[porta];
+            melhorPorta = porta;
+        }
+    }
+    if (melhorCusto >= custoMaximo) {
+        melhorCusto = CUSTO_INFINITO;
+        melhorSalto = TabelaRoteamento::SEM_ROTA;
+        melhorPorta = -1;
+    }
+    
+    // Vetor de caminho: o caminho também muda quando o vizinho troca de rota sem mudar o custo
+    bool mesmoCaminho = true;
+    if (vetorCaminho) {
+        static const std::vector<int> semCaminho;
+        const std::vector<int>& anunciado = melhorPorta >= 0 ? caminhosAnunciadosPorPorta[melhorPorta][destino] : semCaminho;
+        const std::vector<int>& atual = (size_t)destino < caminhoPorDestino.size() ? caminhoPorDestino[destino] : semCaminho;
+        mesmoCaminho = melhorPorta >= 0 ? atual.size() == anunciado.size() + 1 && atual[0] == melhorSalto
+                                              && std::equal(anunciado.begin(), anunciado.end(), atual.begin() + 1)
+                                        : atual.empty();
+        if (!mesmoCaminho) {
+            if (melhorPorta >= 0) {
+                atribuirCaminho(destino, melhorSalto, anunciado.data(), anunciado.size());
+            } else {
+                caminhoPorDestino[destino].clear();
+            }
+        }
+    }
+    
+    // Entre enlaces paralelos a porta pode mudar sem mudar a rota (mesmo custo e próximo
+    // salto): a FIB é atualizada mesmo assim
+    atualizarFib(destino, melhorPorta >= 0 ? melhorPorta : TabelaEncaminhamento::SEM_PORTA);
+    if (melhorCusto == tabela.custo(destino) && melhorSalto == tabela.proximoSalto(destino) && mesmoCaminho) {
+        return false;
+    }
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " recalculou rota para no" << destino << ": custo " << melhorCusto
+       << " via no" << melhorSalto << endl;
+    tabela.definir(destino, melhorCusto, melhorSalto);
+    return true;
+}
+
+void Roteador::recalcularRotasVia(int vizinho) {
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        if (tabela.proximoSalto(destino) == vizinho && recalcularRota(destino)) {
+            destinosAlterados.push_back(destino);
+        }
     }
 }
 
 void Roteador::imprimirTabelaRoteamento(const char* motivo) {
+    // O(N) por chamada: só no nível mais detalhado
+    if (!registrando(LOG_TABELAS)) {
+        return;
+    }
     EV << "=== Tabela de Roteamento do Nó " << getFullName() << " (" << motivo << ") ===" << endl;
-    for (std::map<int, double>::const_iterator it = tabelaRoteamento.begin(); 
-         it != tabelaRoteamento.end(); ++it) {
-        int destino = it->first;
-        double custo = it->second;
-        EV << "  Destino: no" << destino << " | Custo: " << custo
-           << " | Próximo Salto: no" << proximosSaltos[destino] << endl;
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        EV << "  Destino: " << nomeDestino(destino) << " | Custo: " << tabela.custo(destino)
+           << " | Próximo Salto: no" << tabela.proximoSalto(destino) << endl;
     }
     EV << "==========================================" << endl;
 }
 
+std::string Roteador::nomeDestino(int indice) const {
+    if (tamanhoArea <= 0) {
+        return "no" + std::to_string(indice);
+    }
+    if (indice >= tamanhoArea) {
+        return "area" + std::to_string(indice - tamanhoArea);
+    }
+    return "no" + std::to_string(minhaArea * tamanhoArea + indice);
+}
+
 void Roteador::registrarMensagemEnviada() {
     totalMensagensEnviadas++;
-    EV << "Nó " << getFullName() << " enviou mensagem #" << totalMensagensEnviadas << endl;
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " enviou mensagem #" << totalMensagensEnviadas << endl;
 }
 
 void Roteador::registrarMensagemRecebida() {
     totalMensagensRecebidas++;
-    EV << "Nó " << getFullName() << " recebeu mensagem #" << totalMensagensRecebidas << endl;
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " recebeu mensagem #" << totalMensagensRecebidas << endl;
 }
 
 void Roteador::verificarConsistenciaRoteamento() {
+    if (!registrando(LOG_TABELAS)) {
+        return;
+    }
     EV << "=== Verificação de Consistência - Nó " << getFullName() << " ===" << endl;
     
     // Verifica se todos os caminhos são consistentes
-    for (std::map<int, double>::const_iterator it = tabelaRoteamento.begin(); 
-         it != tabelaRoteamento.end(); ++it) {
-        int destino = it->first;
-        double custo = it->second;
-        int numeroNo = extrairNumeroNo(getFullName());
-        if (destino != numeroNo) {
-            int proximoSalto = proximosSaltos[destino];
-            double custoDireto = custoVizinhos[proximoSalto];
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        double custo = tabela.custo(destino);
+        if (destino != meuEndereco) {
+            int proximoSalto = tabela.proximoSalto(destino);
+            double custoDireto = 0;
+            for (size_t i = 0; i < vizinhoPorPorta.size(); i++) {
+                if (vizinhoPorPorta[i] == proximoSalto) {
+                    custoDireto = custoPorPorta[i];
+                    break;
+                }
+            }
             
             if (custoDireto > 0) {
-                EV << "  Destino no" << destino << ": caminho via no" << proximoSalto 
+                EV << "  Destino " << nomeDestino(destino) << ": caminho via no" << proximoSalto 
                    << " (custo: " << custo << ")" << endl;
             }
+            
+            // Vetor de caminho: o caminho começa no próximo salto, termina no destino e não volta a este nó
+            if (vetorCaminho && custo < CUSTO_INFINITO) {
+                const std::vector<int>& caminho = caminhoPorDestino[destino];
+                bool coerente = !caminho.empty() && caminho.front() == proximoSalto && caminho.back() == destino
+                                && std::find(caminho.begin(), caminho.end(), meuEndereco) == caminho.end();
+                EV << "    caminho:";
+                for (size_t i = 0; i < caminho.size(); i++) {
+                    EV << " no" << caminho[i];
+                }
+                EV << (coerente ? "" : " (INCOERENTE)") << endl;
+            }
         }
     }
     EV << "==========================================" << endl;
 }
 
+void Roteador::adicionarAoValidador(ValidadorRoteamento& validador) const {
+    if (falhou) {
+        validador.adicionarNoInativo(meuEndereco);
+        return;
+    }
+    validador.adicionarNo(meuEndereco, &tabela);
+    for (size_t porta = 0; porta < vizinhoPorPorta.size(); porta++) {
+        if (portaAtiva[porta] && vizinhoPorPorta[porta] >= 0) {
+            validador.adicionarEnlace(meuEndereco, vizinhoPorPorta[porta], custoPorPorta[porta]);
+        }
+    }
+}
+
+bool Roteador::enderecoMenor(const Roteador *a, const Roteador *b) {
+    return a->meuEndereco < b->meuEndereco;
+}
+
+void Roteador::prepararValidacao(ValidadorRoteamento& validador) const {
+    validador.definirAreas(tamanhoArea);
+}
+
+void Roteador::exportarTopologia(std::ostream& saida) const {
+    if (falhou) {
+        return;
+    }
+    char custo[32];
+    saida << "no " << meuEndereco << " " << getFullName() << "\n";
+    for (size_t porta = 0; porta < vizinhoPorPorta.size(); porta++) {
+        if (portaAtiva[porta] && vizinhoPorPorta[porta] >= 0) {
+            // Precisão completa, para o solucionador somar exatamente os mesmos custos
+            snprintf(custo, sizeof(custo), "%.17g", custoPorPorta[porta]);
+            saida << "enlace " << meuEndereco << " " << vizinhoPorPorta[porta] << " " << custo << "\n";
+        }
+    }
+}
+
+void Roteador::exportarTabela(std::ostream& saida) const {
+    if (falhou) {
+        return;
+    }
+    std::vector<double> custos(tabela.capacidade(), CUSTO_INFINITO);
+    std::vector<int> proximosSaltos(tabela.capacidade(), TabelaRoteamento::SEM_ROTA);
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        custos[destino] = tabela.custo(destino);
+        proximosSaltos[destino] = tabela.proximoSalto(destino);
+    }
+    SolucionadorReferencia::escreverTabela(saida, getFullName(), "FINAL", custos, proximosSaltos);
+}
+
+void Roteador::exportarTabelaBinaria(EscritorTabelas& escritor) const {
+    if (falhou) {
+        escritor.adicionarNo(meuEndereco, getFullName(), EscritorTabelas::FLAG_FALHOU);
+        return;
+    }
+    escritor.adicionarNo(meuEndereco, getFullName());
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        simtime_t instante = (size_t)destino < instanteAlteracaoPorDestino.size()
+                             ? instanteAlteracaoPorDestino[destino] : SIMTIME_ZERO;
+        escritor.adicionarEntrada(destino, tabela.custo(destino), tabela.proximoSalto(destino), instante.dbl());
+    }
+}
+
+void Roteador::exportarRede() {
+    std::vector<Roteador *> roteadores;
+    if (!coletarRoteadores(roteadores)) {
+        EV_NIVEL(LOG_RESUMO) << "Exportação da topologia e das tabelas ignorada: simulação particionada" << endl;
+        return;
+    }
+    // Em ordem de endereço, a mesma em que o solucionador de referência imprime as tabelas
+    std::sort(roteadores.begin(), roteadores.end(), enderecoMenor);
+    
+    std::string arquivoTopologia = par("arquivoTopologia").stdstringValue();
+    if (!arquivoTopologia.empty()) {
+        std::ofstream saida(arquivoTopologia.c_str());
+        if (!saida) {
+            throw cRuntimeError("Não foi possível criar o arquivo de topologia '%s'", arquivoTopologia.c_str());
+        }
+        saida << "# Topologia final exportada por " << getFullPath() << " em t=" << simTime() << "s\n";
+        for (size_t i = 0; i < roteadores.size(); i++) {
+            roteadores[i]->exportarTopologia(saida);
+        }
+        EV_NIVEL(LOG_RESUMO) << "Topologia de " << roteadores.size() << " roteadores exportada para " << arquivoTopologia << endl;
+    }
+    
+    std::string arquivoTabelas = par("arquivoTabelas").stdstringValue();
+    if (!arquivoTabelas.empty()) {
+        std::ofstream saida(arquivoTabelas.c_str());
+        if (!saida) {
+            throw cRuntimeError("Não foi possível criar o arquivo de tabelas '%s'", arquivoTabelas.c_str());
+        }
+        for (size_t i = 0; i < roteadores.size(); i++) {
+            roteadores[i]->exportarTabela(saida);
+        }
+        EV_NIVEL(LOG_RESUMO) << "Tabelas finais exportadas para " << arquivoTabelas << endl;
+    }
+    
+    std::string arquivoTabelasBinario = par("arquivoTabelasBinario").stdstringValue();
+    if (!arquivoTabelasBinario.empty()) {
+        EscritorTabelas escritor;
+        for (size_t i = 0; i < roteadores.size(); i++) {
+            roteadores[i]->exportarTabelaBinaria(escritor);
+        }
+        try {
+            escritor.escrever(arquivoTabelasBinario);
+        }
+        catch (const std::exception& e) {
+            throw cRuntimeError("Exportação binária das tabelas: %s", e.what());
+        }
+        EV_NIVEL(LOG_RESUMO) << "Tabelas finais exportadas em formato colunar para " << arquivoTabelasBinario << endl;
+    }
+}
+
 void Roteador::finish() {
     // Coleta estatísticas finais
-    EV << "=== ESTATÍSTICAS FINAIS - Nó " << getFullName() << " ===" << endl;
-    EV << "Total de mensagens enviadas: " << totalMensagensEnviadas << endl;
-    EV << "Total de mensagens recebidas: " << totalMensagensRecebidas << endl;
-    EV << "Tempo de convergência: " << tempoConvergencia << "s" << endl;
-    EV << "Convergiu: " << (convergiu ? "SIM" : "NÃO") << endl;
-    EV << "Destinos conhecidos: " << destinosConhecidos.size() << endl;
-    EV << "Fase final: " << faseAtual << endl;
-    EV << "Relógio global final: " << relogioGlobal << "s" << endl;
-    EV << "==========================================" << endl;
+    EV_NIVEL(LOG_RESUMO) << "=== ESTATÍSTICAS FINAIS - Nó " << getFullName() << " ===" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Total de mensagens enviadas: " << totalMensagensEnviadas << endl;
+    EV_NIVEL(LOG_RESUMO) << "Total de mensagens recebidas: " << totalMensagensRecebidas << endl;
+    EV_NIVEL(LOG_RESUMO) << "Tempo de convergência: " << tempoConvergencia << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Convergiu: " << (convergiu ? "SIM" : "NÃO") << endl;
+    EV_NIVEL(LOG_RESUMO) << "Aviso de convergência recebido em: " << tempoDeteccao << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Última alteração local da tabela: " << ultimaAlteracaoLocal << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Mensagens de controle enviadas: " << totalMensagensControle << endl;
+    EV_NIVEL(LOG_RESUMO) << "Destinos conhecidos: " << tabela.tamanho() << endl;
+    EV_NIVEL(LOG_RESUMO) << "Fase final: " << faseAtual << endl;
+    EV_NIVEL(LOG_RESUMO) << "Relógio global final: " << relogioGlobal << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Entradas de tabela enviadas: " << totalEntradasEnviadas
+       << " (anúncios completos: " << totalAnunciosCompletos << ", delta: " << totalAnunciosDelta << ")" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Atualizações agrupadas: " << totalAtualizacoesAgrupadas << endl;
+    EV_NIVEL(LOG_RESUMO) << "Entradas suprimidas (horizonte dividido): " << totalEntradasSuprimidas
+       << " | envenenadas: " << totalEntradasEnvenenadas << endl;
+    if (vetorCaminho) {
+        EV_NIVEL(LOG_RESUMO) << "Caminhos rejeitados (vetor de caminho): " << totalCaminhosRejeitados << endl;
+    }
+    if (tamanhoArea > 0) {
+        EV_NIVEL(LOG_RESUMO) << "Área " << minhaArea << ": entradas internas resumidas para outras áreas: "
+           << totalEntradasResumidas << endl;
+    }
+    EV_NIVEL(LOG_RESUMO) << "Bytes enviados: " << totalBytesEnviados << endl;
+    if (modoTrafego != TRAFEGO_DESATIVADO) {
+        EV_NIVEL(LOG_RESUMO) << "Pacotes de dados gerados: " << totalPacotesGerados << " | entregues: " << totalPacotesEntregues
+           << " | encaminhados: " << totalPacotesEncaminhados << endl;
+        EV_NIVEL(LOG_RESUMO) << "Pacotes descartados: sem rota " << totalDescartesSemRota << " | laço " << totalDescartesLaco
+           << " | enlace caído " << totalDescartesEnlace << endl;
+    }
+    EV_NIVEL(LOG_RESUMO) << "==========================================" << endl;
     
     // Registra escalares para análise
     recordScalar("mensagens_enviadas", totalMensagensEnviadas);
     recordScalar("mensagens_recebidas", totalMensagensRecebidas);
     recordScalar("tempo_convergencia", tempoConvergencia);
     recordScalar("convergiu", convergiu ? 1 : 0);
-    recordScalar("destinos_conhecidos", destinosConhecidos.size());
+    recordScalar("tempo_deteccao", tempoDeteccao);
+    recordScalar("ultima_alteracao_local", ultimaAlteracaoLocal);
+    recordScalar("mensagens_controle", totalMensagensControle);
+    recordScalar("destinos_conhecidos", tabela.tamanho());
     recordScalar("fase_final", faseAtual);
     recordScalar("relogio_global_final", relogioGlobal);
+    recordScalar("entradas_enviadas", totalEntradasEnviadas);
+    recordScalar("anuncios_completos", totalAnunciosCompletos);
+    recordScalar("anuncios_delta", totalAnunciosDelta);
+    recordScalar("lacunas_sequencia", totalLacunasSequencia);
+    recordScalar("atualizacoes_agrupadas", totalAtualizacoesAgrupadas);
+    recordScalar("entradas_suprimidas", totalEntradasSuprimidas);
+    recordScalar("entradas_envenenadas", totalEntradasEnvenenadas);
+    recordScalar("bytes_enviados", totalBytesEnviados);
+    recordScalar("bytes_estado_roteamento", tabela.bytesOcupados());
+    if (tamanhoArea > 0) {
+        recordScalar("area", minhaArea);
+        recordScalar("entradas_resumidas", totalEntradasResumidas);
+    }
+    if (vetorCaminho) {
+        recordScalar("caminhos_rejeitados", totalCaminhosRejeitados);
+    }
+    if (modoTrafego != TRAFEGO_DESATIVADO) {
+        recordScalar("pacotes_gerados", totalPacotesGerados);
+        recordScalar("pacotes_entregues", totalPacotesEntregues);
+        recordScalar("pacotes_encaminhados", totalPacotesEncaminhados);
+        recordScalar("descartes_sem_rota", totalDescartesSemRota);
+        recordScalar("descartes_laco", totalDescartesLaco);
+        recordScalar("descartes_enlace", totalDescartesEnlace);
+        recordScalar("bytes_fib", fib.bytesOcupados());
+        recordScalar("intervalos_fib", fib.numIntervalos());
+    }
+    if (dinamico) {
+        recordScalar("falhou", falhou ? 1 : 0);
+        if (par("isStarter").boolValue()) {
+            recordScalar("epocas_cenario", instantesCenario.size());
+            recordScalar("epocas_reconvergidas", epocasReconvergidas);
+        }
+    }
+    
+    // Soma dos custos das rotas: resume a tabela para comparar execuções (ex.: sequencial e paralela).
+    // Destinos que ficaram inalcançáveis num cenário dinâmico não entram na soma
+    double custoTotalRotas = 0;
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        if (tabela.custo(destino) < CUSTO_INFINITO) {
+            custoTotalRotas += tabela.custo(destino);
+        }
+    }
+    recordScalar("custo_total_rotas", custoTotalRotas);
+    
+    if (par("validarRotas").boolValue() && par("isStarter").boolValue()) {
+        validarRotasGlobalmente();
+    }
+    if (par("isStarter").boolValue()) {
+        registrarEstadoRede();
+        registrarAlocacoes();
+        if (modoTrafego != TRAFEGO_DESATIVADO) {
+            registrarPlanoDados();
+        }
+    }
+    if (par("isStarter").boolValue()
+        && (!par("arquivoTopologia").stdstringValue().empty() || !par("arquivoTabelas").stdstringValue().empty()
+            || !par("arquivoTabelasBinario").stdstringValue().empty())) {
+        exportarRede();
+    }
+}
+
+// Memória de roteamento somada em todos os nós: quanto a hierarquia de áreas poupa em
+// relação à tabela plana (O(N) por nó, O(N²) na rede)
+void Roteador::registrarEstadoRede() {
+    std::vector<Roteador *> roteadores;
+    if (!coletarRoteadores(roteadores)) {
+        return;
+    }
+    uint64_t bytesRede = 0;
+    size_t maiorTabela = 0;
+    for (size_t i = 0; i < roteadores.size(); i++) {
+        bytesRede += roteadores[i]->tabela.bytesOcupados();
+        maiorTabela = std::max(maiorTabela, roteadores[i]->tabela.capacidade());
+    }
+    EV_NIVEL(LOG_RESUMO) << "Estado de roteamento da rede: " << bytesRede << " bytes em " << roteadores.size()
+       << " nós (maior tabela: " << maiorTabela << " entradas)" << endl;
+    recordScalar("bytes_estado_roteamento_rede", bytesRede);
+    recordScalar("maior_tabela", maiorTabela);
+}
+
+// Totais do plano de dados na rede. A taxa de encaminhamento usa o tempo de parede do
+// primeiro ao último evento de dados, que inclui o controle processado no intervalo
+void Roteador::registrarPlanoDados() {
+    std::vector<Roteador *> roteadores;
+    if (!coletarRoteadores(roteadores)) {
+        return;
+    }
+    int64_t gerados = 0, entregues = 0, encaminhados = 0, descartados = 0;
+    for (size_t i = 0; i < roteadores.size(); i++) {
+        const Roteador *roteador = roteadores[i];
+        gerados += roteador->totalPacotesGerados;
+        entregues += roteador->totalPacotesEntregues;
+        encaminhados += roteador->totalPacotesEncaminhados;
+        descartados += roteador->totalDescartesSemRota + roteador->totalDescartesLaco + roteador->totalDescartesEnlace;
+    }
+    double segundos = paredeDadosMarcada ? std::chrono::duration<double>(fimParedeDados - inicioParedeDados).count() : 0;
+    double taxa = segundos > 0 ? encaminhados / segundos : 0;
+    EV_NIVEL(LOG_RESUMO) << "Plano de dados: " << gerados << " pacotes gerados, " << entregues << " entregues, "
+       << descartados << " descartados, " << gerados - entregues - descartados << " em trânsito no fim" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Encaminhamentos: " << encaminhados << " em " << segundos << "s de parede ("
+       << taxa << " por segundo)" << endl;
+    recordScalar("pacotes_gerados_rede", gerados);
+    recordScalar("pacotes_entregues_rede", entregues);
+    recordScalar("pacotes_descartados_rede", descartados);
+    recordScalar("taxa_entrega_rede", gerados > 0 ? (double)entregues / gerados : 0.0);
+    recordScalar("encaminhamentos_por_segundo_parede", taxa);
+}
+
+// Alocações desde o primeiro evento da simulação, de todo o processo: a arena das mensagens,
+// o pool de retratos de tabela e, com "make CONTAR_ALOCACOES=1", o operator new global
+void Roteador::registrarAlocacoes() {
+    eventnumber_t eventos = getSimulation()->getEventNumber() - eventoInicial;
+    const ArenaClasses::Estatisticas& arena = ArenaClasses::estatisticas();
+    const PoolAnuncios::Estatisticas& anuncios = PoolAnuncios::estatisticas();
+    recordScalar("eventos", eventos);
+    recordScalar("arena_alocacoes", arena.alocacoes - arenaNoInicio.alocacoes);
+    recordScalar("arena_reaproveitadas", arena.reaproveitadas - arenaNoInicio.reaproveitadas);
+    recordScalar("arena_pedacos", arena.pedacos - arenaNoInicio.pedacos);
+    recordScalar("retratos_obtidos", anuncios.obtidos - anunciosNoInicio.obtidos);
+    recordScalar("retratos_reaproveitados", anuncios.reaproveitados - anunciosNoInicio.reaproveitados);
+    EV_NIVEL(LOG_RESUMO) << "Eventos: " << eventos << " | blocos da arena: " << arena.alocacoes - arenaNoInicio.alocacoes
+       << " (" << arena.reaproveitadas - arenaNoInicio.reaproveitadas << " reaproveitados) | retratos: "
+       << anuncios.obtidos - anunciosNoInicio.obtidos << " (" << anuncios.reaproveitados - anunciosNoInicio.reaproveitados
+       << " reaproveitados)" << endl;
+    if (contandoAlocacoes()) {
+        uint64_t alocacoes = alocacoesDoProcesso() - alocacoesNoInicio;
+        recordScalar("alocacoes", alocacoes);
+        recordScalar("alocacoes_por_evento", eventos > 0 ? (double)alocacoes / eventos : 0.0);
+        EV_NIVEL(LOG_RESUMO) << "Alocações do processo: " << alocacoes << " ("
+           << (eventos > 0 ? (double)alocacoes / eventos : 0.0) << " por evento)" << endl;
+    }
 }
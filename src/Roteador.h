@@ -2,53 +2,284 @@
 #define __PROVA_ROTEADOR_H_
 
 #include <omnetpp.h>
-#include <map>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
-#include "Mensagem_m.h"
+#include "ArquivoTabelas.h"
+#include "PoolAlocacao.h"
+#include "RoteadorBase.h"
+#include "TabelaEncaminhamento.h"
+#include "TabelaRoteamento.h"
+#include "ValidadorRoteamento.h"
 
 using namespace omnetpp;
 
-class Roteador : public cSimpleModule {
+class Roteador : public RoteadorBase {
   private:
+    // Filtro de horizonte dividido aplicado ao anúncio de cada porta
+    enum ModoHorizonteDividido {
+        HORIZONTE_DESATIVADO,         // Anuncia a tabela inteira em todas as portas
+        HORIZONTE_SIMPLES,            // Omite rotas aprendidas pelo vizinho da porta
+        HORIZONTE_REVERSO_ENVENENADO  // Anuncia essas rotas com custo infinito
+    };
+    
+    // Custo anunciado para rotas envenenadas
+    static constexpr double CUSTO_INFINITO = TabelaRoteamento::CUSTO_INFINITO;
+    
+    // Evento do cenário dinâmico que afeta este nó
+    enum TipoEvento {
+        EVENTO_ATRASO,    // Novo atraso (custo) do enlace
+        EVENTO_DESLIGAR,  // Enlace desligado (ou vizinho falhou)
+        EVENTO_LIGAR,     // Enlace religado
+        EVENTO_FALHA      // Este nó falha e para de responder
+    };
+    
+    // Geração de pacotes do plano de dados em cada nó
+    enum ModoTrafego {
+        TRAFEGO_DESATIVADO,
+        TRAFEGO_POISSON,  // Intervalos exponenciais de média intervaloPacotes
+        TRAFEGO_CBR       // Intervalo fixo, com fase sorteada em cada nó
+    };
+    // Motivo do descarte de um pacote de dados (valor do sinal pacoteDescartado)
+    enum MotivoDescarte {
+        DESCARTE_SEM_ROTA = 1,  // Destino sem rota ou próximo salto por enlace desligado
+        DESCARTE_LACO = 2,      // ttlPacotes esgotado: o pacote circulou em um laço
+        DESCARTE_ENLACE = 3     // Em trânsito quando o enlace caiu ou chegou a um nó que falhou
+    };
+    struct EventoCenario {
+        int epoca;        // Instante do cenário em que ocorre (1 = primeiro)
+        TipoEvento tipo;
+        int porta;        // Porta afetada (-1 em EVENTO_FALHA)
+        double atraso;    // EVENTO_ATRASO: novo atraso do enlace
+    };
+    
     int meuId;
-    std::map<int, double> tabelaRoteamento;  // Tabela de custos para cada destino
-    std::map<int, int> proximosSaltos;       // Próximo salto para cada destino
-    std::map<int, double> custoVizinhos;     // Custo direto para cada vizinho
+    TabelaRoteamento tabela;                 // Custo, próximo salto e versão por destino (densa)
+    std::vector<int> destinosAlterados;      // Destinos melhorados pela última mensagem (reutilizado)
+    std::vector<simtime_t> instanteAlteracaoPorDestino;  // Última alteração da rota de cada destino (exportação)
     
     // Métricas para coleta de dados
     int totalMensagensEnviadas;
     int totalMensagensRecebidas;
-    simtime_t tempoInicial;
-    simtime_t tempoConvergencia;
-    bool convergiu;
-    
-    // Para verificação de consistência
-    std::vector<int> destinosConhecidos;
 
     // Relógio global
     simtime_t relogioGlobal;
     int faseAtual;
     bool aguardandoSincronizacao;
 
+    // Propagação incremental (delta)
+    bool modoDelta;                                   // true: envia apenas destinos alterados
+    simtime_t intervaloSincronizacao;                 // Período da sincronização completa (0 = desativada)
+    cMessage *temporizadorSincronizacao = nullptr;
+    unsigned long versaoTabela;                       // Incrementada a cada alteração da tabela
+    unsigned long versaoSincronizada;                 // Versão da tabela na última sincronização completa
+    std::vector<std::pair<unsigned long, int>> registroAlteracoes;  // (versão, destino) em ordem crescente
+    std::vector<unsigned long> versaoAnunciadaPorPorta;  // Última versão anunciada em cada porta
+    std::vector<bool> portaSincronizada;              // false: próximo anúncio na porta deve ser completo
+    std::vector<int> sequenciaPorPorta;               // Próximo número de sequência a enviar
+    std::vector<int> sequenciaRecebidaPorPorta;       // Último número de sequência recebido
+    int totalEntradasEnviadas;
+    int totalAnunciosCompletos;
+    int totalAnunciosDelta;
+    int totalLacunasSequencia;
+
+    // Agrupamento de atualizações disparadas (coalescing)
+    simtime_t janelaAgrupamento;                      // Janela de agrupamento (0 = propaga imediatamente)
+    cMessage *temporizadorAgrupamento = nullptr;
+    int totalAtualizacoesAgrupadas;                   // Atualizações absorvidas por uma propagação pendente
+
+    // Horizonte dividido (split horizon)
+    ModoHorizonteDividido horizonteDividido;
+    std::unordered_map<int, int> portaDoVizinho;      // Primeira porta que leva a cada vizinho
+    std::vector<int> primeiraPortaDoVizinho;          // Por porta: primeira porta com o mesmo vizinho
+    int totalEntradasSuprimidas;                      // Entradas omitidas pelo horizonte dividido simples
+    int totalEntradasEnvenenadas;                     // Entradas anunciadas com custo infinito
+
+    // Codificação na rede (a fila de transmissão das portas fica no RoteadorBase)
+    std::vector<unsigned> bytesPorEntrada;            // Parcela de cada entrada do último retrato (reutilizado)
+
+    // Detecção de terminação (Dijkstra-Scholten, no RoteadorBase)
+    std::vector<int> deficitPorPorta;                 // Parcela do déficit em cada porta (descartada se o enlace cai)
+    simtime_t ultimaAlteracaoLocal;                   // Instante da última alteração da própria tabela
+
+    // Várias origens: cada origem livre ao partir é raiz de uma árvore própria; a terminação
+    // global é decidida por uma onda de eco do coordenador (nó isStarter), que só retorna
+    // por nós livres e origens que já partiram, isto é, depois que todas as árvores se desfizeram
+    bool variasOrigens;
+    bool partidaPendente;                             // Origem cujo IniciarPI ainda não disparou
+    int epocaEco;                                     // Época a que a onda de eco atual se refere
+    bool sondagemRecebida;
+    bool ecoEnviado;
+    int portaPaiEco;                                  // Porta de onde veio a sondagem (-1 = coordenador)
+    int ecosPendentes;                                // Portas que ainda não responderam à sondagem
+    simtime_t ultimaAlteracaoEco;                     // Maior última alteração das árvores e ecos recebidos
+    int anunciosEco;                                  // Anúncios da época somados pelos ecos recebidos
+
+    // Cenário dinâmico (parâmetro cenario): mudanças de enlace e falhas de nós em instantes
+    // dados. Os eventos de um mesmo instante formam uma época; os nós afetados viram raízes
+    // de novas computações difusas e o coordenador mede a reconvergência com uma onda de eco
+    bool dinamico;
+    double custoMaximo;                               // Custo a partir do qual o destino é inalcançável
+    std::vector<simtime_t> instantesCenario;          // Instante de cada época (época k no índice k-1)
+    std::vector<EventoCenario> eventosCenario;        // Eventos que afetam este nó, em ordem de época
+    size_t proximoEventoCenario;
+    cMessage *temporizadorCenario = nullptr;
+    int epocaAtual;                                   // Épocas do cenário já iniciadas
+    int anunciosInicioEpoca;                          // totalMensagensEnviadas no início da época atual
+    bool falhou;                                      // Nó parado por um evento de falha
+    std::vector<std::vector<double>> custosAnunciadosPorPorta;  // Adj-RIB-In: último custo anunciado em cada porta
+    cOutVector vetorReconvergencia;                   // Coordenador: tempo de reconvergência de cada época
+    cOutVector vetorAnunciosEpoca;                    // Coordenador: anúncios enviados na rede em cada época
+    int epocasReconvergidas;
+
+    // Estatísticas ao longo do tempo (sinais declarados com @statistic em Roteador.ned)
+    static simsignal_t sinalRotasConhecidas;
+    static simsignal_t sinalSomaCustos;
+    static simsignal_t sinalMensagensEmTransito;
+    static simsignal_t sinalAlteracoesPorFase;
+    static simsignal_t sinalTempoProcessamento;
+    int rotasAlcancaveis;                             // Destinos com custo finito
+    double somaCustosRotas;                           // Soma dos custos finitos da tabela
+    std::vector<double> custoContabilizado;           // Custo de cada destino já incluído na soma
+    int alteracoesDaFase;                             // Destinos alterados desde a última propagação
+
+    // Vetor de caminho: cada rota guarda os nós até o destino (a partir do próximo salto) e
+    // os anúncios os levam; o receptor descarta a entrada cujo caminho já passa por ele
+    bool vetorCaminho;
+    std::vector<std::vector<int>> caminhoPorDestino;  // Vazio para o próprio nó e destinos inalcançáveis
+    std::vector<std::vector<std::vector<int>>> caminhosAnunciadosPorPorta;  // Cenário dinâmico: caminho de cada entrada da Adj-RIB-In
+    int totalCaminhosRejeitados;                      // Entradas descartadas por conterem este nó
+
+    // Roteamento hierárquico (tamanhoArea > 0): a área de um endereço é endereco / tamanhoArea.
+    // A tabela guarda as rotas internas da área nos índices 0..tamanhoArea-1 e uma entrada
+    // resumida por área a partir de tamanhoArea (ver indiceDestino). Os vizinhos de outra
+    // área só recebem as entradas resumidas, então os nós de borda resumem a sua área
+    int tamanhoArea;
+    int minhaArea;
+    int totalEntradasResumidas;                       // Entradas internas omitidas nas portas para outras áreas
+
+    // Plano de dados (parâmetro trafego): os nós injetam pacotes a destinos sorteados ou
+    // listados, e cada nó os encaminha pelo próximo salto atual da sua tabela. Os pacotes
+    // dividem a fila das portas com o controle, mas não entram na detecção de terminação
+    ModoTrafego modoTrafego;
+    TabelaEncaminhamento fib;                         // Porta de saída por índice da tabela, escrita a cada decisão de rota
+    simtime_t intervaloPacotes;
+    simtime_t fimTrafego;                             // Depois deste instante o nó não injeta mais
+    int ttlPacotes;
+    int tamanhoPacote;
+    std::vector<int> destinosTrafego;                 // Destinos configurados, sem o próprio nó (vazio = qualquer nó)
+    cMessage *temporizadorTrafego = nullptr;
+    int64_t totalPacotesGerados;
+    int64_t totalPacotesEntregues;
+    int64_t totalPacotesEncaminhados;                 // Decisões de encaminhamento (na origem e em cada salto)
+    int64_t totalDescartesSemRota;
+    int64_t totalDescartesLaco;
+    int64_t totalDescartesEnlace;
+    static simsignal_t sinalAtrasoPacote;
+    static simsignal_t sinalSaltosPacote;
+    static simsignal_t sinalPacoteDescartado;
+    // Comuns a todos os nós do processo: endereços da rede para o sorteio dos destinos e
+    // tempo de parede entre o primeiro e o último evento de dados (taxa de encaminhamento)
+    static std::vector<int> enderecosRede;
+    static bool enderecosColetados;
+    static bool paredeDadosMarcada;
+    static std::chrono::steady_clock::time_point inicioParedeDados;
+    static std::chrono::steady_clock::time_point fimParedeDados;
+
+    // Alocações a partir do primeiro evento da simulação (comuns a todos os nós do processo)
+    static bool inicioEventosMarcado;
+    static eventnumber_t eventoInicial;
+    static uint64_t alocacoesNoInicio;
+    static ArenaClasses::Estatisticas arenaNoInicio;
+    static PoolAnuncios::Estatisticas anunciosNoInicio;
+
+  public:
+    virtual ~Roteador();
+    
+    // Índice da tabela para o endereço de destino: o próprio endereço ou, com hierarquia, o
+    // endereço dentro da área (destinos da mesma área) ou a entrada resumida da área do destino
+    int indiceDestino(int endereco) const {
+        if (tamanhoArea <= 0) {
+            return endereco;
+        }
+        int area = endereco / tamanhoArea;
+        return area == minhaArea ? endereco % tamanhoArea : tamanhoArea + area;
+    }
+    
+    // Validação global: acrescenta este nó, sua tabela e seus enlaces ativos (só o endereço, se falhou)
+    virtual void adicionarAoValidador(ValidadorRoteamento& validador) const override;
+    // Exportação para o solucionador de referência: declarações "no"/"enlace" deste nó e
+    // sua tabela final (nada, se falhou)
+    void exportarTopologia(std::ostream& saida) const;
+    void exportarTabela(std::ostream& saida) const;
+    // Exportação colunar: este nó no índice e suas entradas (só o nó, marcado, se falhou)
+    void exportarTabelaBinaria(EscritorTabelas& escritor) const;
+
   protected:
     virtual void initialize() override;
     virtual void handleMessage(cMessage *msg) override;
     virtual void finish() override;
     
-    // Função para extrair número do nó do nome (ex: "no0" -> 0)
-    int extrairNumeroNo(const std::string& nomeNo);
-    
     // Métodos baseados em PI (Propagação de Informação)
     void iniciarPropagacaoInformacao();
     void propagarInformacao();
+    AnuncioTabelaPtr montarAnuncio(bool completa, unsigned long versaoBase, std::vector<int>& entradasViaPorta,
+                                   std::vector<size_t>& bytesViaPorta);
     void processarInformacaoRecebida(Mensagem *msg);
-    void verificarConvergencia();
+    void agendarPropagacao();
+    void registrarAlteracao(int destino);
+    void contabilizarRota(int destino);
+    void emitirEstadoTabela();
+    void sincronizarVizinhos();
+    // Terminação (RoteadorBase): agrupamento pendente, déficit por porta, várias origens
+    // e cenário dinâmico (onda de eco) e o início do tráfego na convergência
+    virtual bool ocioso() const override;
+    virtual void confirmacaoContada(int porta) override;
+    virtual void raizLiberada() override;
+    virtual void computacaoDeixada() override;
+    virtual void aoConvergir() override;
+    void enviarSondagem(int portaOrigem);
+    void processarSondagem(Mensagem *msg);
+    void processarEco(Mensagem *msg);
+    void verificarEco();
+    void reiniciarEco(int epoca);
+    int contarPortasAtivas();
+    
+    // Plano de dados
+    void agendarTrafego(simtime_t inicio);
+    void injetarPacote();
+    int sortearDestino();
+    void atualizarFib(int destino, int porta);
+    void encaminharPacote(Mensagem *pacote);
+    void descartarPacote(Mensagem *pacote, MotivoDescarte motivo);
+    void marcarParedeDados();
+    
+    // Cenário dinâmico e reconvergência incremental
+    void carregarCenario();
+    void iniciarEpocaCenario();
+    void desligarPorta(int porta);
+    void ligarPorta(int porta);
+    void alterarAtrasoPorta(int porta, double atraso);
+    void falharNo();
+    void aplicarAnuncioDinamico(const AnuncioTabela& anuncio, int porta, int numeroVizinho, int vizinhoExcluido);
+    void anotarAnuncio(int porta, int destino, double custo, const int *caminho = nullptr, size_t tamanhoCaminho = 0);
+    void atribuirCaminho(int destino, int vizinho, const int *nos, size_t numNos);
+    bool recalcularRota(int destino);
+    void recalcularRotasVia(int vizinho);
     void imprimirTabelaRoteamento(const char* motivo);
+    std::string nomeDestino(int indice) const;
     
     // Métricas e análise
     void registrarMensagemEnviada();
     void registrarMensagemRecebida();
     void verificarConsistenciaRoteamento();
+    static bool enderecoMenor(const Roteador *a, const Roteador *b);
+    virtual void prepararValidacao(ValidadorRoteamento& validador) const override;
+    void exportarRede();
+    void registrarEstadoRede();
+    void registrarPlanoDados();
+    void registrarAlocacoes();
 };
 
 #endif
@@ -0,0 +1,172 @@
+// Parte comum aos motores de roteamento: fila das portas, terminação e validação global
+
+#include "RoteadorBase.h"
+
+int RoteadorBase::extrairNumeroNo(const std::string& nomeNo) {
+    // Dígitos finais do nome, ignorando um índice entre colchetes: "no12", "host123", "host[123]"
+    size_t fim = nomeNo.length();
+    if (fim > 0 && nomeNo[fim - 1] == ']') {
+        fim--;
+    }
+    size_t inicio = fim;
+    while (inicio > 0 && nomeNo[inicio - 1] >= '0' && nomeNo[inicio - 1] <= '9') {
+        inicio--;
+    }
+    if (inicio == fim) {
+        return -1;
+    }
+    return std::stoi(nomeNo.substr(inicio, fim - inicio));
+}
+
+int RoteadorBase::resolverEndereco(cModule *modulo) {
+    // 1. Parâmetro NED explícito
+    if (modulo->hasPar("endereco") && modulo->par("endereco").intValue() >= 0) {
+        return modulo->par("endereco").intValue();
+    }
+    // 2. Índice no vetor de submódulos (no[i], host[i])
+    if (modulo->isVector()) {
+        return modulo->getIndex();
+    }
+    // 3. Número no nome do módulo (no0, no1, ...)
+    return extrairNumeroNo(modulo->getName());
+}
+
+int RoteadorBase::lerNivelLog(cModule *modulo) {
+    std::string nivel = modulo->par("nivelLog").stdstringValue();
+    if (nivel == "nenhum") {
+        return LOG_NENHUM;
+    } else if (nivel == "resumo") {
+        return LOG_RESUMO;
+    } else if (nivel == "mensagens") {
+        return LOG_MENSAGENS;
+    } else if (nivel == "tabelas") {
+        return LOG_TABELAS;
+    }
+    throw cRuntimeError("nivelLog inválido: '%s' (use \"nenhum\", \"resumo\", \"mensagens\" ou \"tabelas\")", nivel.c_str());
+}
+
+void RoteadorBase::enviarPelaPorta(Mensagem *msg, int porta) {
+    totalBytesEnviados += msg->getByteLength();
+    transmitir(msg, porta);
+}
+
+// Em canais com taxa de transmissão, a mensagem espera a anterior terminar de sair (os
+// pacotes de dados entram na mesma fila que o controle, mas não nos bytes de roteamento)
+void RoteadorBase::transmitir(cMessage *msg, int porta) {
+    cGate *saida = gate("portas$o", porta);
+    cChannel *canal = saida->findTransmissionChannel();
+    simtime_t espera = SIMTIME_ZERO;
+    if (canal != nullptr) {
+        if (portaLivreEm[porta] > simTime()) {
+            espera = portaLivreEm[porta] - simTime();
+        }
+        portaLivreEm[porta] = simTime() + espera + canal->calculateDuration(msg);
+    }
+    sendDelayed(msg, espera, saida);
+}
+
+void RoteadorBase::enviarConfirmacao(int porta, simtime_t ultimaAlteracao) {
+    Mensagem *confirmacao = new Mensagem("Confirmacao", MSG_CONFIRMACAO);
+    confirmacao->setIdNoOrigem(meuEndereco);
+    confirmacao->setUltimaAlteracao(ultimaAlteracao);
+    confirmacao->setByteLength(codificacao.bytesControle(meuEndereco));
+    enviarPelaPorta(confirmacao, porta);
+    totalMensagensControle++;
+}
+
+void RoteadorBase::processarConfirmacao(Mensagem *msg) {
+    deficit--;
+    confirmacaoContada(msg->getArrivalGate()->getIndex());
+    if (msg->getUltimaAlteracao() > ultimaAlteracaoSubarvore) {
+        ultimaAlteracaoSubarvore = msg->getUltimaAlteracao();
+    }
+    verificarConvergencia();
+}
+
+void RoteadorBase::verificarConvergencia() {
+    // O nó deixa a computação quando está ocioso e todos os anúncios que enviou já foram
+    // confirmados
+    if (!engajado || deficit > 0 || !ocioso()) {
+        return;
+    }
+
+    engajado = false;
+    if (portaPai == -1) {
+        raizLiberada();
+    } else {
+        // Reporta ao pai a última alteração vista nesta subárvore
+        enviarConfirmacao(portaPai, ultimaAlteracaoSubarvore);
+        portaPai = -1;
+    }
+    ultimaAlteracaoSubarvore = SIMTIME_ZERO;
+    computacaoDeixada();
+}
+
+void RoteadorBase::raizLiberada() {
+    // Raiz sem pendências: nenhuma tabela da rede pode mais mudar
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " detectou a terminação da propagação (última alteração em "
+       << ultimaAlteracaoSubarvore << "s)" << endl;
+    difundirConvergencia(ultimaAlteracaoSubarvore, -1);
+}
+
+void RoteadorBase::difundirConvergencia(simtime_t tempoQuiescencia, int portaOrigem) {
+    // Cada nó repassa o aviso apenas na primeira vez que o recebe
+    if (convergiu) {
+        return;
+    }
+
+    convergiu = true;
+    tempoConvergencia = tempoQuiescencia - tempoInicial;
+    tempoDeteccao = simTime();
+    EV_NIVEL(LOG_RESUMO) << "Nó " << getFullName() << " CONVERGIU em " << tempoConvergencia
+       << "s (aviso recebido em " << tempoDeteccao << "s)" << endl;
+
+    aoConvergir();
+
+    for (size_t i = 0; i < portaAtiva.size(); i++) {
+        if ((int)i == portaOrigem || !portaAtiva[i]) {
+            continue;
+        }
+        Mensagem *aviso = new Mensagem("AvisoConvergencia", MSG_CONVERGENCIA);
+        aviso->setIdNoOrigem(meuEndereco);
+        aviso->setUltimaAlteracao(tempoQuiescencia);
+        aviso->setByteLength(codificacao.bytesControle(meuEndereco));
+        enviarPelaPorta(aviso, i);
+        totalMensagensControle++;
+    }
+}
+
+void RoteadorBase::validarRotasGlobalmente() {
+    std::vector<RoteadorBase *> roteadores;
+    if (!coletarRoteadores(roteadores)) {
+        EV_NIVEL(LOG_RESUMO) << "Validação global das rotas ignorada: simulação particionada" << endl;
+        return;
+    }
+    ValidadorRoteamento validador;
+    int numRoteadores = roteadores.size();
+    for (size_t i = 0; i < roteadores.size(); i++) {
+        roteadores[i]->adicionarAoValidador(validador);
+    }
+    prepararValidacao(validador);
+    validador.amostrarDestinos(par("destinosValidacao").intValue());
+
+    ValidadorRoteamento::Resultado resultado = validador.validar(par("toleranciaValidacao").doubleValue(),
+                                                                 par("threadsValidacao").intValue());
+    EV_NIVEL(LOG_RESUMO) << "=== Validação global das rotas (" << numRoteadores << " roteadores) ===" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Rotas verificadas: " << resultado.rotasVerificadas << " | ótimas: " << resultado.rotasOtimas << endl;
+    EV_NIVEL(LOG_RESUMO) << "Subótimas: " << resultado.rotasSubotimas << " (maior excesso: " << resultado.maiorExcesso << "s)"
+       << " | em laço: " << resultado.rotasEmLaco << " | interrompidas: " << resultado.rotasInterrompidas << endl;
+    EV_NIVEL(LOG_RESUMO) << "Custos de tabela divergentes do ótimo: " << resultado.custosDivergentes << endl;
+    EV_NIVEL(LOG_RESUMO) << "Estiramento (custo encaminhado / ótimo): médio " << resultado.estiramentoMedio()
+       << " | máximo " << resultado.maiorEstiramento << endl;
+    EV_NIVEL(LOG_RESUMO) << "==========================================" << endl;
+
+    recordScalar("validacao_rotas_verificadas", resultado.rotasVerificadas);
+    recordScalar("validacao_rotas_subotimas", resultado.rotasSubotimas);
+    recordScalar("validacao_rotas_em_laco", resultado.rotasEmLaco);
+    recordScalar("validacao_rotas_interrompidas", resultado.rotasInterrompidas);
+    recordScalar("validacao_custos_divergentes", resultado.custosDivergentes);
+    recordScalar("validacao_maior_excesso", resultado.maiorExcesso);
+    recordScalar("validacao_estiramento_medio", resultado.estiramentoMedio());
+    recordScalar("validacao_estiramento_maximo", resultado.maiorEstiramento);
+}
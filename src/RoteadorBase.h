@@ -0,0 +1,126 @@
+#ifndef __PROVA_ROTEADORBASE_H_
+#define __PROVA_ROTEADORBASE_H_
+
+#include <omnetpp.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CodificacaoAnuncio.h"
+#include "Mensagem_m.h"
+#include "ValidadorRoteamento.h"
+
+using namespace omnetpp;
+
+// Níveis de log dos roteadores; o parâmetro nivelLog escolhe até qual nível é registrado
+enum NivelLog {
+    LOG_NENHUM = 0,
+    LOG_RESUMO = 1,      // Início, convergência, eventos do cenário e estatísticas finais
+    LOG_MENSAGENS = 2,   // Cada mensagem enviada ou recebida e cada rota alterada
+    LOG_TABELAS = 3      // Tabela inteira a cada atualização e verificação de consistência
+};
+
+// Maior nível compilado: os registros acima dele somem do código (o teste é constante).
+// Por padrão, o modo release (NDEBUG) mantém só o resumo; "make NIVEL_LOG=n" escolhe outro
+#ifndef PROVA_NIVEL_LOG
+#ifdef NDEBUG
+#define PROVA_NIVEL_LOG LOG_RESUMO
+#else
+#define PROVA_NIVEL_LOG LOG_TABELAS
+#endif
+#endif
+
+// EV condicionado ao nível: EV_NIVEL(LOG_MENSAGENS) << ... << endl;
+#define EV_NIVEL(nivel) if (!registrando(nivel)) ; else EV
+
+// Parte comum aos motores de roteamento (Roteador e RoteadorEstadoEnlace): endereço e log,
+// fila de transmissão das portas, detecção de terminação de Dijkstra-Scholten com o aviso
+// de convergência e validação global das rotas. O que cada motor faz de diferente nesses
+// pontos entra pelos métodos virtuais abaixo; os membros são preenchidos no initialize()
+// de cada um.
+class RoteadorBase : public cSimpleModule {
+  protected:
+    int nivelLog;                                     // Parâmetro nivelLog, limitado por PROVA_NIVEL_LOG
+    int meuEndereco;                                  // Endereço lógico, resolvido na inicialização
+    std::vector<int> vizinhoPorPorta;                 // Endereço do vizinho em cada porta (-1 = desconectada)
+    std::vector<double> custoPorPorta;                // Custo do enlace de saída de cada porta
+    std::vector<bool> portaAtiva;                     // false: sem aviso de convergência (enlace desligado, vizinho falhou)
+
+    // Codificação na rede: tamanho das mensagens e fila de transmissão por porta
+    CodificacaoAnuncio codificacao;
+    std::vector<simtime_t> portaLivreEm;              // Fim da última transmissão agendada em cada porta
+    int64_t totalBytesEnviados;
+    int totalMensagensControle;                       // Confirmações, avisos de convergência e ondas de eco
+
+    // Convergência
+    simtime_t tempoInicial;
+    simtime_t tempoConvergencia;
+    simtime_t tempoDeteccao;                          // Instante em que o aviso de convergência chegou
+    bool convergiu;
+
+    // Detecção de terminação (Dijkstra-Scholten) enraizada no nó inicial
+    bool engajado;                                    // Participa da computação difusa
+    int portaPai;                                     // Porta do pai na árvore de engajamento (-1 = raiz)
+    int deficit;                                      // Anúncios enviados ainda não confirmados
+    simtime_t ultimaAlteracaoSubarvore;               // Maior instante de alteração ainda não reportado ao pai
+
+  public:
+    // Função para extrair número do nó do nome (ex: "no0" -> 0, "host[12]" -> 12)
+    static int extrairNumeroNo(const std::string& nomeNo);
+    // Endereço de um nó: parâmetro "endereco", índice no vetor ou número no nome
+    static int resolverEndereco(cModule *modulo);
+    // Parâmetro nivelLog do módulo como NivelLog (lança cRuntimeError se inválido)
+    static int lerNivelLog(cModule *modulo);
+
+    // Validação global: acrescenta este nó, sua tabela e seus enlaces
+    virtual void adicionarAoValidador(ValidadorRoteamento& validador) const = 0;
+
+  protected:
+    bool registrando(int nivel) const { return nivel <= PROVA_NIVEL_LOG && nivel <= nivelLog; }
+
+    // Envio: enviarPelaPorta conta a mensagem nos bytes de roteamento; transmitir só a
+    // coloca na fila da porta (também usado pelos pacotes de dados)
+    void enviarPelaPorta(Mensagem *msg, int porta);
+    void transmitir(cMessage *msg, int porta);
+
+    // Dijkstra-Scholten: cada anúncio recebido é confirmado, exceto o que engaja o nó, que
+    // é confirmado quando ele deixa a computação; a raiz difunde então o aviso de convergência
+    void enviarConfirmacao(int porta, simtime_t ultimaAlteracao);
+    void processarConfirmacao(Mensagem *msg);
+    void verificarConvergencia();
+    void difundirConvergencia(simtime_t tempoQuiescencia, int portaOrigem);
+
+    // Pontos de extensão da terminação
+    virtual bool ocioso() const { return true; }           // Sem propagação ou SPF pendente
+    virtual void confirmacaoContada(int porta) {}          // Depois de descontar a confirmação do déficit
+    virtual void raizLiberada();                           // Padrão: a raiz difunde a convergência
+    virtual void computacaoDeixada() {}                    // Depois que o nó deixa a computação
+    virtual void aoConvergir() {}                          // Primeiro aviso, antes de repassá-lo
+
+    // Validação com os roteadores de todo o processo; sem visão global (simulação
+    // particionada), só registra que foi ignorada
+    void validarRotasGlobalmente();
+    virtual void prepararValidacao(ValidadorRoteamento& validador) const {}
+
+    // Roteadores do tipo T na simulação; false em execução paralela, quando parte deles está
+    // em outras partições (só há módulos substitutos aqui) e a visão global não é possível
+    template <typename T>
+    bool coletarRoteadores(std::vector<T *>& roteadores) {
+        cSimulation *simulacao = getSimulation();
+        for (int id = 0; id <= simulacao->getLastComponentId(); id++) {
+            cModule *modulo = simulacao->getModule(id);
+            if (modulo == nullptr) {
+                continue;
+            }
+            if (modulo->isPlaceholder()) {
+                return false;
+            }
+            T *roteador = dynamic_cast<T *>(modulo);
+            if (roteador != nullptr) {
+                roteadores.push_back(roteador);
+            }
+        }
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,390 @@
+// Motor de roteamento por estado de enlace (inundação de LSAs e Dijkstra local)
+
+#include <algorithm>
+#include "RoteadorEstadoEnlace.h"
+
+Define_Module(RoteadorEstadoEnlace);
+
+RoteadorEstadoEnlace::~RoteadorEstadoEnlace() {
+    cancelAndDelete(temporizadorSpf);
+}
+
+void RoteadorEstadoEnlace::initialize() {
+    nivelLog = lerNivelLog(this);
+
+    totalMensagensEnviadas = 0;
+    totalMensagensRecebidas = 0;
+    totalAnunciosRepetidos = 0;
+    totalEntradasEnviadas = 0;
+    totalBytesEnviados = 0;
+    totalMensagensControle = 0;
+    totalExecucoesSpf = 0;
+    tempoInicial = simTime();
+    tempoConvergencia = SIMTIME_ZERO;
+    tempoDeteccao = SIMTIME_ZERO;
+    ultimaAlteracaoLocal = SIMTIME_ZERO;
+    relogioGlobal = SIMTIME_ZERO;
+    convergiu = false;
+
+    engajado = false;
+    portaPai = -1;
+    deficit = 0;
+    ultimaAlteracaoSubarvore = SIMTIME_ZERO;
+
+    // Mesma codificação do Roteador: tamanho dos LSAs e quantização dos custos anunciados
+    std::string formato = par("codificacao").stdstringValue();
+    if (formato != "nativa" && formato != "compacta") {
+        throw cRuntimeError("codificacao inválida: '%s' (use \"nativa\" ou \"compacta\")", formato.c_str());
+    }
+    double resolucaoCusto = par("resolucaoCusto").doubleValue();
+    if (resolucaoCusto < 0) {
+        throw cRuntimeError("resolucaoCusto não pode ser negativa");
+    }
+    codificacao.configurar(formato == "compacta" ? CodificacaoAnuncio::FORMATO_COMPACTO : CodificacaoAnuncio::FORMATO_NATIVO,
+                           resolucaoCusto, false);
+
+    atrasoSpf = par("atrasoSpf").doubleValue();
+    if (atrasoSpf < SIMTIME_ZERO) {
+        throw cRuntimeError("atrasoSpf não pode ser negativo");
+    }
+    if (atrasoSpf > SIMTIME_ZERO) {
+        temporizadorSpf = new cMessage("SpfEstadoEnlace");
+    }
+    spfIncremental = par("spfIncremental").boolValue();
+
+    std::string nomeNo = getFullName();
+    meuEndereco = resolverEndereco(this);
+    if (meuEndereco == -1) {
+        throw cRuntimeError("Não foi possível determinar o endereço do nó '%s' "
+                            "(defina o parâmetro endereco ou use nomes como no0 ou host[0])", nomeNo.c_str());
+    }
+    WATCH(meuEndereco);
+
+    // A base começa vazia; o próprio LSA só é originado quando a inundação chega a este nó
+    minhaSequencia = 0;
+    anunciou = false;
+    sequenciaPorOrigem.clear();
+    anuncioPorOrigem.clear();
+    origensPendentes.clear();
+    origemPendente.clear();
+    arvore.reiniciar(meuEndereco);
+    tabela.definir(meuEndereco, 0.0, meuEndereco);
+
+    int numPortas = gateSize("portas");
+    vizinhoPorPorta.assign(numPortas, -1);
+    custoPorPorta.assign(numPortas, CUSTO_INFINITO);
+    portaAtiva.assign(numPortas, false);
+    portaLivreEm.assign(numPortas, SIMTIME_ZERO);
+    for (int i = 0; i < numPortas; ++i) {
+        cGate *gateSaida = gate("portas$o", i);
+        if (gateSaida->getChannel() != nullptr) {
+            int numeroVizinho = resolverEndereco(gateSaida->getPathEndGate()->getOwnerModule());
+            if (numeroVizinho != -1) {
+                vizinhoPorPorta[i] = numeroVizinho;
+                custoPorPorta[i] = gateSaida->getChannel()->par("delay").doubleValue();
+                portaAtiva[i] = true;
+            }
+        }
+    }
+
+    if (par("isStarter").boolValue()) {
+        EV_NIVEL(LOG_RESUMO) << "Nó " << nomeNo << " iniciando a inundação de estado de enlace..." << endl;
+        scheduleAt(simTime() + uniform(0, par("janelaPartida").doubleValue()), new cMessage("IniciarEstadoEnlace"));
+    }
+}
+
+void RoteadorEstadoEnlace::handleMessage(cMessage *msg) {
+    if (msg == temporizadorSpf) {
+        executarSpf();
+        verificarConvergencia();
+        return;
+    }
+
+    if (strcmp(msg->getName(), "IniciarEstadoEnlace") == 0) {
+        // O nó inicial é a raiz da árvore de terminação
+        engajado = true;
+        portaPai = -1;
+        originarAnuncio();
+        verificarConvergencia();
+        delete msg;
+        return;
+    }
+
+    Mensagem *msgRecebida = check_and_cast<Mensagem *>(msg);
+    switch (msgRecebida->getKind()) {
+        case MSG_ESTADO_ENLACE:
+            processarAnuncio(msgRecebida);
+            break;
+        case MSG_CONFIRMACAO:
+            processarConfirmacao(msgRecebida);
+            break;
+        case MSG_CONVERGENCIA:
+            difundirConvergencia(msgRecebida->getUltimaAlteracao(), msgRecebida->getArrivalGate()->getIndex());
+            break;
+        default:
+            throw cRuntimeError("Tipo de mensagem desconhecido: %d", msgRecebida->getKind());
+    }
+    delete msgRecebida;
+}
+
+void RoteadorEstadoEnlace::originarAnuncio() {
+    // Vizinhos em ordem crescente (exigida pela codificação compacta); entre enlaces
+    // paralelos até o mesmo vizinho, vale o mais barato
+    std::vector<std::pair<int, double>> enlaces;
+    for (size_t i = 0; i < vizinhoPorPorta.size(); i++) {
+        if (vizinhoPorPorta[i] >= 0) {
+            enlaces.push_back(std::make_pair(vizinhoPorPorta[i], codificacao.quantizar(custoPorPorta[i])));
+        }
+    }
+    std::sort(enlaces.begin(), enlaces.end());
+
+    std::shared_ptr<AnuncioTabela> anuncio = PoolAnuncios::obter();
+    anuncio->destinos.reserve(enlaces.size());
+    anuncio->custos.reserve(enlaces.size());
+    for (size_t j = 0; j < enlaces.size(); j++) {
+        if (!anuncio->destinos.empty() && anuncio->destinos.back() == enlaces[j].first) {
+            continue;
+        }
+        anuncio->destinos.push_back(enlaces[j].first);
+        anuncio->custos.push_back(enlaces[j].second);
+    }
+    anuncio->bytesEntradas = codificacao.bytesEntradas(*anuncio, bytesPorEntrada);
+
+    anunciou = true;
+    int sequencia = minhaSequencia++;
+    instalarAnuncio(meuEndereco, sequencia, anuncio);
+
+    int64_t bytes = codificacao.bytesCabecalho(meuEndereco, sequencia, anuncio->tamanho()) + anuncio->bytesEntradas;
+    for (size_t i = 0; i < vizinhoPorPorta.size(); i++) {
+        if (vizinhoPorPorta[i] >= 0) {
+            enviarAnuncio(meuEndereco, sequencia, anuncio, bytes, i);
+        }
+    }
+    EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " originou o LSA #" << sequencia << " com "
+       << anuncio->tamanho() << " enlaces" << endl;
+    agendarSpf();
+}
+
+void RoteadorEstadoEnlace::enviarAnuncio(int origem, int sequencia, const AnuncioTabelaPtr& anuncio, int64_t bytes, int porta) {
+    Mensagem *lsa = new Mensagem("EstadoEnlace", MSG_ESTADO_ENLACE);
+    lsa->setIdNoOrigem(origem);
+    lsa->setNumeroSequencia(sequencia);
+    lsa->setCompleta(true);
+    lsa->setAnuncio(anuncio);
+    lsa->setByteLength(bytes);
+    enviarPelaPorta(lsa, porta);
+    totalMensagensEnviadas++;
+    totalEntradasEnviadas += anuncio->tamanho();
+    deficit++;
+}
+
+void RoteadorEstadoEnlace::processarAnuncio(Mensagem *msg) {
+    totalMensagensRecebidas++;
+    if (simTime() > relogioGlobal) {
+        relogioGlobal = simTime();
+    }
+    int porta = msg->getArrivalGate()->getIndex();
+    int origem = msg->getIdNoOrigem();
+
+    // Dijkstra-Scholten: o LSA que engaja o nó torna o remetente seu pai; os demais
+    // (inclusive os repetidos) são confirmados imediatamente
+    if (!engajado) {
+        engajado = true;
+        portaPai = porta;
+    } else {
+        enviarConfirmacao(porta, SIMTIME_ZERO);
+    }
+
+    bool novo = instalarAnuncio(origem, msg->getNumeroSequencia(), msg->getAnuncio());
+    if (novo) {
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " instalou LSA #" << msg->getNumeroSequencia()
+           << " de no" << origem << " recebido pela porta " << porta << endl;
+        // Repassa o mesmo retrato (e o mesmo tamanho) a todas as outras portas
+        for (size_t i = 0; i < vizinhoPorPorta.size(); i++) {
+            if ((int)i != porta && vizinhoPorPorta[i] >= 0) {
+                enviarAnuncio(origem, msg->getNumeroSequencia(), msg->getAnuncio(), msg->getByteLength(), i);
+            }
+        }
+    } else {
+        totalAnunciosRepetidos++;
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " descartou LSA repetido de no" << origem
+           << " (#" << msg->getNumeroSequencia() << ") recebido pela porta " << porta << endl;
+    }
+
+    // A inundação chegou a este nó: origina o próprio LSA (o SPF segue junto)
+    if (!anunciou) {
+        originarAnuncio();
+    } else if (novo) {
+        agendarSpf();
+    }
+    verificarConvergencia();
+}
+
+bool RoteadorEstadoEnlace::instalarAnuncio(int origem, int sequencia, const AnuncioTabelaPtr& anuncio) {
+    if ((size_t)origem >= sequenciaPorOrigem.size()) {
+        sequenciaPorOrigem.resize(origem + 1, -1);
+        anuncioPorOrigem.resize(origem + 1);
+        origemPendente.resize(origem + 1, 0);
+    }
+    if (sequencia <= sequenciaPorOrigem[origem]) {
+        return false;
+    }
+    sequenciaPorOrigem[origem] = sequencia;
+    anuncioPorOrigem[origem] = anuncio;
+    if (!origemPendente[origem]) {
+        origemPendente[origem] = 1;
+        origensPendentes.push_back(origem);
+    }
+    return true;
+}
+
+void RoteadorEstadoEnlace::agendarSpf() {
+    if (atrasoSpf <= SIMTIME_ZERO) {
+        executarSpf();
+        return;
+    }
+    // LSAs que chegam com o SPF já agendado entram no mesmo cálculo
+    if (!temporizadorSpf->isScheduled()) {
+        scheduleAt(simTime() + atrasoSpf, temporizadorSpf);
+    }
+}
+
+void RoteadorEstadoEnlace::executarSpf() {
+    totalExecucoesSpf++;
+
+    // Aplica à árvore os LSAs instalados desde o último SPF: cada um corrige só a parte da
+    // árvore que ele afeta, ou, sem o modo incremental, a árvore é refeita do zero
+    for (size_t k = 0; k < origensPendentes.size(); k++) {
+        int origem = origensPendentes[k];
+        const AnuncioTabela& anuncio = *anuncioPorOrigem[origem];
+        if (spfIncremental) {
+            arvore.atualizar(origem, anuncio.destinos.data(), anuncio.custos.data(), anuncio.tamanho());
+        } else {
+            arvore.substituir(origem, anuncio.destinos.data(), anuncio.custos.data(), anuncio.tamanho());
+        }
+        origemPendente[origem] = 0;
+    }
+    origensPendentes.clear();
+    if (!spfIncremental) {
+        arvore.recalcular();
+    }
+#ifndef NDEBUG
+    else {
+        int divergente;
+        if (!arvore.conferir(divergente)) {
+            throw cRuntimeError("SPF incremental do nó %s divergiu do cálculo completo no destino no%d "
+                                "(distância %g)", getFullName(), divergente, arvore.distancia(divergente));
+        }
+    }
+#endif
+
+    // Só os destinos que a árvore tocou podem ter mudado. Destinos inalcançáveis não entram
+    // na tabela: como os LSAs nunca são retirados (cada nó origina o seu uma vez), um destino
+    // alcançável não volta a ficar inalcançável
+    bool tabelaAtualizada = false;
+    const std::vector<int>& tocados = arvore.tocados();
+    for (size_t k = 0; k < tocados.size(); k++) {
+        int destino = tocados[k];
+        double distancia = arvore.distancia(destino);
+        int salto = arvore.primeiroSalto(destino);
+        if (distancia >= CUSTO_INFINITO) {
+            continue;
+        }
+        if (tabela.conhece(destino) && tabela.custo(destino) == distancia && tabela.proximoSalto(destino) == salto) {
+            continue;
+        }
+        tabela.definir(destino, distancia, salto);
+        EV_NIVEL(LOG_MENSAGENS) << "Nó " << getFullName() << " atualizou rota para no" << destino
+           << " via no" << salto << " (custo: " << distancia << ")" << endl;
+        ultimaAlteracaoLocal = simTime();
+        ultimaAlteracaoSubarvore = simTime();
+        tabelaAtualizada = true;
+    }
+    arvore.limparTocados();
+    if (tabelaAtualizada) {
+        imprimirTabelaRoteamento("Após SPF");
+    }
+}
+
+bool RoteadorEstadoEnlace::ocioso() const {
+    return temporizadorSpf == nullptr || !temporizadorSpf->isScheduled();
+}
+
+void RoteadorEstadoEnlace::imprimirTabelaRoteamento(const char *motivo) {
+    if (!registrando(LOG_TABELAS)) {
+        return;
+    }
+    EV << "=== Tabela de Roteamento do Nó " << getFullName() << " (" << motivo << ") ===" << endl;
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        EV << "  Destino: no" << destino << " | Custo: " << tabela.custo(destino)
+           << " | Próximo Salto: no" << tabela.proximoSalto(destino) << endl;
+    }
+    EV << "==========================================" << endl;
+}
+
+void RoteadorEstadoEnlace::adicionarAoValidador(ValidadorRoteamento& validador) const {
+    validador.adicionarNo(meuEndereco, &tabela);
+    for (size_t porta = 0; porta < vizinhoPorPorta.size(); porta++) {
+        if (vizinhoPorPorta[porta] >= 0) {
+            validador.adicionarEnlace(meuEndereco, vizinhoPorPorta[porta], custoPorPorta[porta]);
+        }
+    }
+}
+
+void RoteadorEstadoEnlace::finish() {
+    EV_NIVEL(LOG_RESUMO) << "=== ESTATÍSTICAS FINAIS - Nó " << getFullName() << " (estado de enlace) ===" << endl;
+    EV_NIVEL(LOG_RESUMO) << "LSAs enviados: " << totalMensagensEnviadas << " | recebidos: " << totalMensagensRecebidas
+       << " (repetidos: " << totalAnunciosRepetidos << ")" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Tempo de convergência: " << tempoConvergencia << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Convergiu: " << (convergiu ? "SIM" : "NÃO") << endl;
+    EV_NIVEL(LOG_RESUMO) << "Aviso de convergência recebido em: " << tempoDeteccao << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Última alteração local da tabela: " << ultimaAlteracaoLocal << "s" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Mensagens de controle enviadas: " << totalMensagensControle << endl;
+    EV_NIVEL(LOG_RESUMO) << "Destinos conhecidos: " << tabela.tamanho() << endl;
+    EV_NIVEL(LOG_RESUMO) << "Execuções do SPF: " << totalExecucoesSpf << " (" << (spfIncremental ? "incremental" : "completo")
+       << ", " << arvore.estatisticas().nosProcessados << " nós processados)" << endl;
+    EV_NIVEL(LOG_RESUMO) << "Bytes enviados: " << totalBytesEnviados << endl;
+    EV_NIVEL(LOG_RESUMO) << "==========================================" << endl;
+
+    // Mesmos escalares do Roteador, para comparar os motores; os que não se aplicam ao
+    // estado de enlace (fases, deltas, agrupamento, horizonte dividido) ficam em zero
+    recordScalar("mensagens_enviadas", totalMensagensEnviadas);
+    recordScalar("mensagens_recebidas", totalMensagensRecebidas);
+    recordScalar("tempo_convergencia", tempoConvergencia);
+    recordScalar("convergiu", convergiu ? 1 : 0);
+    recordScalar("tempo_deteccao", tempoDeteccao);
+    recordScalar("ultima_alteracao_local", ultimaAlteracaoLocal);
+    recordScalar("mensagens_controle", totalMensagensControle);
+    recordScalar("destinos_conhecidos", tabela.tamanho());
+    recordScalar("fase_final", 0);
+    recordScalar("relogio_global_final", relogioGlobal);
+    recordScalar("entradas_enviadas", totalEntradasEnviadas);
+    recordScalar("anuncios_completos", totalMensagensEnviadas);
+    recordScalar("anuncios_delta", 0);
+    recordScalar("lacunas_sequencia", 0);
+    recordScalar("atualizacoes_agrupadas", 0);
+    recordScalar("entradas_suprimidas", 0);
+    recordScalar("entradas_envenenadas", 0);
+    recordScalar("bytes_enviados", totalBytesEnviados);
+    // Só a tabela, como no vetor de distâncias (o LSDB e a árvore de caminhos são O(enlaces))
+    recordScalar("bytes_estado_roteamento", tabela.bytesOcupados());
+    recordScalar("execucoes_spf", totalExecucoesSpf);
+    recordScalar("spf_nos_processados", arvore.estatisticas().nosProcessados);
+    recordScalar("spf_nos_invalidados", arvore.estatisticas().nosInvalidados);
+    recordScalar("anuncios_repetidos", totalAnunciosRepetidos);
+
+    // Como no Roteador, só os custos finitos entram na soma
+    double custoTotalRotas = 0;
+    for (int destino = tabela.primeiro(); destino != TabelaRoteamento::SEM_ROTA;
+         destino = tabela.seguinte(destino)) {
+        if (tabela.custo(destino) < CUSTO_INFINITO) {
+            custoTotalRotas += tabela.custo(destino);
+        }
+    }
+    recordScalar("custo_total_rotas", custoTotalRotas);
+
+    if (par("validarRotas").boolValue() && par("isStarter").boolValue()) {
+        validarRotasGlobalmente();
+    }
+}
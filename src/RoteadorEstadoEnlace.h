@@ -0,0 +1,81 @@
+#ifndef __PROVA_ROTEADORESTADOENLACE_H_
+#define __PROVA_ROTEADORESTADOENLACE_H_
+
+#include <omnetpp.h>
+#include <cstdint>
+#include <vector>
+#include "ArvoreCaminhos.h"
+#include "Mensagem_m.h"
+#include "RoteadorBase.h"
+#include "TabelaRoteamento.h"
+
+using namespace omnetpp;
+
+// Roteamento por estado de enlace, alternativa ao vetor de distâncias do Roteador (mesma
+// interface IRoteador). Cada nó anuncia uma vez os seus enlaces em um LSA (Mensagem do tipo
+// MSG_ESTADO_ENLACE: idNoOrigem e numeroSequencia identificam o LSA; o retrato leva os
+// vizinhos em 'destinos' e o custo de cada enlace em 'custos'). Um LSA mais novo que o da
+// base é instalado e repassado a todas as outras portas; a tabela vem de uma árvore de
+// caminhos mínimos sobre a base de LSAs (ArvoreCaminhos), corrigida a cada LSA novo só
+// onde ele a afeta.
+//
+// O nó inicial origina o primeiro LSA; os demais originam o seu ao receber o primeiro LSA.
+// Como no Roteador, todo LSA é confirmado (Dijkstra-Scholten, no RoteadorBase) e a raiz
+// difunde o aviso de convergência quando o seu déficit zera, isto é, quando todos os LSAs
+// foram entregues e todos os SPFs executados.
+class RoteadorEstadoEnlace : public RoteadorBase {
+  private:
+    static constexpr double CUSTO_INFINITO = TabelaRoteamento::CUSTO_INFINITO;
+
+    TabelaRoteamento tabela;
+
+    // Base de LSAs, indexada pelo endereço de origem
+    std::vector<int> sequenciaPorOrigem;              // -1: nenhum LSA recebido dessa origem
+    std::vector<AnuncioTabelaPtr> anuncioPorOrigem;
+    int minhaSequencia;
+    bool anunciou;                                    // O próprio LSA já foi originado
+
+    // SPF: a árvore de caminhos mínimos reflete os LSAs já aplicados; os instalados desde o
+    // último SPF esperam em origensPendentes
+    simtime_t atrasoSpf;                              // Janela de agrupamento dos LSAs novos (0 = imediato)
+    cMessage *temporizadorSpf = nullptr;
+    bool spfIncremental;                              // false: Dijkstra completo a cada SPF
+    ArvoreCaminhos arvore;
+    std::vector<int> origensPendentes;
+    std::vector<unsigned char> origemPendente;
+    int totalExecucoesSpf;
+
+    std::vector<unsigned> bytesPorEntrada;            // Parcela de cada enlace do próprio LSA (codificação)
+
+    // Métricas (mesmos escalares do Roteador)
+    int totalMensagensEnviadas;                       // LSAs enviados (originados e repassados)
+    int totalMensagensRecebidas;                      // LSAs recebidos, inclusive repetidos
+    int totalAnunciosRepetidos;                       // LSAs que não eram mais novos que o da base
+    int totalEntradasEnviadas;                        // Enlaces levados pelos LSAs enviados
+    simtime_t ultimaAlteracaoLocal;
+    simtime_t relogioGlobal;                          // Chegada do LSA mais recente
+
+  public:
+    virtual ~RoteadorEstadoEnlace();
+
+    virtual void adicionarAoValidador(ValidadorRoteamento& validador) const override;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+    void originarAnuncio();
+    void enviarAnuncio(int origem, int sequencia, const AnuncioTabelaPtr& anuncio, int64_t bytes, int porta);
+    void processarAnuncio(Mensagem *msg);
+    bool instalarAnuncio(int origem, int sequencia, const AnuncioTabelaPtr& anuncio);
+    void agendarSpf();
+    void executarSpf();
+
+    // Terminação (RoteadorBase): o nó só está ocioso sem SPF agendado
+    virtual bool ocioso() const override;
+
+    void imprimirTabelaRoteamento(const char *motivo);
+};
+
+#endif
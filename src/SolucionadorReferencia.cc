@@ -0,0 +1,382 @@
+// Solucionador centralizado (Dijkstra com heap radix e Δ-stepping) usado como oráculo do PI
+
+#include "SolucionadorReferencia.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+static const double CUSTO_INFINITO = std::numeric_limits<double>::infinity();
+
+// Nós por thread abaixo dos quais uma fase do Δ-stepping roda sem criar threads
+static const size_t NOS_POR_THREAD = 4096;
+
+// Heap radix sobre os bits de doubles não negativos, cuja ordem como inteiros sem sinal é a
+// mesma dos valores. Exige chaves monótonas (nunca menores que a última extraída), como no
+// Dijkstra. O balde de uma chave é a posição do bit mais alto em que difere da última extraída.
+class HeapRadix {
+  public:
+    void limpar() {
+        for (int i = 0; i < NUM_BALDES; i++) {
+            baldes[i].clear();
+        }
+        ultima = 0;
+        tamanho = 0;
+    }
+    bool vazio() const { return tamanho == 0; }
+
+    void inserir(double chave, int no) {
+        uint64_t bitsChave = bits(chave);
+        baldes[indice(bitsChave)].push_back(std::make_pair(bitsChave, no));
+        tamanho++;
+    }
+
+    int extrairMinimo(double& chave) {
+        if (baldes[0].empty()) {
+            // O menor do primeiro balde não vazio vira a nova referência; redistribui o balde,
+            // cujos itens caem todos em baldes menores
+            int i = 1;
+            while (baldes[i].empty()) {
+                i++;
+            }
+            uint64_t menor = baldes[i][0].first;
+            for (size_t k = 1; k < baldes[i].size(); k++) {
+                menor = std::min(menor, baldes[i][k].first);
+            }
+            ultima = menor;
+            for (size_t k = 0; k < baldes[i].size(); k++) {
+                baldes[indice(baldes[i][k].first)].push_back(baldes[i][k]);
+            }
+            baldes[i].clear();
+        }
+        std::pair<uint64_t, int> item = baldes[0].back();
+        baldes[0].pop_back();
+        tamanho--;
+        std::memcpy(&chave, &item.first, sizeof(chave));
+        return item.second;
+    }
+
+  private:
+    static const int NUM_BALDES = 65;
+
+    static uint64_t bits(double valor) {
+        uint64_t resultado;
+        std::memcpy(&resultado, &valor, sizeof(resultado));
+        return resultado;
+    }
+    int indice(uint64_t chave) const {
+        return chave == ultima ? 0 : 64 - __builtin_clzll(chave ^ ultima);
+    }
+
+    std::vector<std::pair<uint64_t, int>> baldes[NUM_BALDES];
+    uint64_t ultima = 0;
+    size_t tamanho = 0;
+};
+
+TopologiaReferencia TopologiaReferencia::carregar(const std::string& arquivo) {
+    std::ifstream entrada(arquivo.c_str());
+    if (!entrada) {
+        throw std::runtime_error("não foi possível abrir a topologia '" + arquivo + "'");
+    }
+    return carregar(entrada);
+}
+
+TopologiaReferencia TopologiaReferencia::carregar(std::istream& entrada) {
+    TopologiaReferencia topologia;
+    std::vector<int> origens, destinos;
+    std::vector<double> custos;
+    std::string linha;
+    int numeroLinha = 0;
+    while (std::getline(entrada, linha)) {
+        numeroLinha++;
+        size_t comentario = linha.find('#');
+        if (comentario != std::string::npos) {
+            linha.erase(comentario);
+        }
+        std::istringstream campos(linha);
+        std::string tipo;
+        if (!(campos >> tipo)) {
+            continue;
+        }
+        std::string resto;
+        if (tipo == "no") {
+            int endereco;
+            std::string nome;
+            if (!(campos >> endereco >> nome) || endereco < 0 || (campos >> resto)) {
+                throw std::runtime_error("linha " + std::to_string(numeroLinha) + ": esperado 'no <endereco> <nome>'");
+            }
+            if ((size_t)endereco >= topologia.nomes.size()) {
+                topologia.nomes.resize(endereco + 1);
+            }
+            topologia.nomes[endereco] = nome;
+        } else if (tipo == "enlace") {
+            int origem, destino;
+            double custo;
+            if (!(campos >> origem >> destino >> custo) || (campos >> resto)) {
+                throw std::runtime_error("linha " + std::to_string(numeroLinha)
+                                         + ": esperado 'enlace <origem> <destino> <custo>'");
+            }
+            if (!(custo >= 0)) {
+                throw std::runtime_error("linha " + std::to_string(numeroLinha) + ": custo negativo");
+            }
+            origens.push_back(origem);
+            destinos.push_back(destino);
+            custos.push_back(custo);
+        } else {
+            throw std::runtime_error("linha " + std::to_string(numeroLinha) + ": declaração desconhecida '" + tipo + "'");
+        }
+    }
+
+    // Os enlaces só podem ligar nós declarados (em qualquer ordem no arquivo)
+    for (size_t i = 0; i < origens.size(); i++) {
+        if (origens[i] < 0 || destinos[i] < 0 || (size_t)origens[i] >= topologia.nomes.size()
+            || (size_t)destinos[i] >= topologia.nomes.size() || !topologia.ativo(origens[i])
+            || !topologia.ativo(destinos[i])) {
+            throw std::runtime_error("enlace " + std::to_string(origens[i]) + " -> " + std::to_string(destinos[i])
+                                     + " entre nós não declarados");
+        }
+    }
+
+    // CSR por origem, mantendo a ordem do arquivo
+    size_t numEnderecos = topologia.nomes.size();
+    topologia.inicio.assign(numEnderecos + 1, 0);
+    for (size_t i = 0; i < origens.size(); i++) {
+        topologia.inicio[origens[i] + 1]++;
+    }
+    for (size_t v = 0; v < numEnderecos; v++) {
+        topologia.inicio[v + 1] += topologia.inicio[v];
+    }
+    topologia.alvos.resize(origens.size());
+    topologia.custos.resize(origens.size());
+    std::vector<int> posicao(topologia.inicio.begin(), topologia.inicio.end() - 1);
+    for (size_t i = 0; i < origens.size(); i++) {
+        int j = posicao[origens[i]]++;
+        topologia.alvos[j] = destinos[i];
+        topologia.custos[j] = custos[i];
+    }
+    return topologia;
+}
+
+void SolucionadorReferencia::dijkstra(int origem, RotasReferencia& rotas) const {
+    HeapRadix heap;
+    dijkstra(origem, rotas, heap);
+}
+
+void SolucionadorReferencia::dijkstra(int origem, RotasReferencia& rotas, HeapRadix& heap) const {
+    size_t numEnderecos = topologia.numEnderecos();
+    rotas.custos.assign(numEnderecos, CUSTO_INFINITO);
+    rotas.proximosSaltos.assign(numEnderecos, SEM_ROTA);
+    if (origem < 0 || (size_t)origem >= numEnderecos || !topologia.ativo(origem)) {
+        return;
+    }
+
+    heap.limpar();
+    rotas.custos[origem] = 0;
+    rotas.proximosSaltos[origem] = origem;
+    heap.inserir(0.0, origem);
+    while (!heap.vazio()) {
+        double custo;
+        int u = heap.extrairMinimo(custo);
+        if (custo > rotas.custos[u]) {
+            continue;
+        }
+        for (int k = topologia.inicio[u]; k < topologia.inicio[u + 1]; k++) {
+            int v = topologia.alvos[k];
+            double candidato = custo + topologia.custos[k];
+            if (candidato < rotas.custos[v]) {
+                rotas.custos[v] = candidato;
+                rotas.proximosSaltos[v] = u == origem ? v : rotas.proximosSaltos[u];
+                heap.inserir(candidato, v);
+            }
+        }
+    }
+}
+
+double SolucionadorReferencia::deltaPadrao() const {
+    // Heurística usual: maior custo de enlace dividido pelo grau médio
+    size_t ativos = 0;
+    for (size_t v = 0; v < topologia.numEnderecos(); v++) {
+        if (topologia.ativo(v)) {
+            ativos++;
+        }
+    }
+    double maiorCusto = 0;
+    for (size_t k = 0; k < topologia.numEnlaces(); k++) {
+        maiorCusto = std::max(maiorCusto, topologia.custos[k]);
+    }
+    if (topologia.numEnlaces() == 0 || maiorCusto <= 0) {
+        return 1;
+    }
+    double grauMedio = (double)topologia.numEnlaces() / ativos;
+    return maiorCusto / std::max(1.0, grauMedio);
+}
+
+void SolucionadorReferencia::deltaStepping(int origem, double delta, unsigned numThreads, RotasReferencia& rotas) const {
+    if (delta <= 0) {
+        delta = deltaPadrao();
+    }
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t numEnderecos = topologia.numEnderecos();
+    rotas.custos.assign(numEnderecos, CUSTO_INFINITO);
+    rotas.proximosSaltos.assign(numEnderecos, SEM_ROTA);
+    if (origem < 0 || (size_t)origem >= numEnderecos || !topologia.ativo(origem)) {
+        return;
+    }
+
+    // Baldes de largura delta; um nó pode ficar em vários baldes, e só vale a entrada do balde
+    // correspondente ao seu custo atual
+    std::vector<std::vector<int>> baldes(1);
+    std::vector<int> fronteira, removidos;
+    std::vector<size_t> rodadaNaFronteira(numEnderecos, 0), baldeRemovido(numEnderecos, 0);
+    std::vector<std::vector<Relaxacao>> pedidos(numThreads);
+    size_t rodada = 0;
+    rotas.custos[origem] = 0;
+    rotas.proximosSaltos[origem] = origem;
+    baldes[0].push_back(origem);
+
+    for (size_t i = 0; i < baldes.size(); i++) {
+        removidos.clear();
+        while (!baldes[i].empty()) {
+            // Fase leve: os nós do balde relaxam seus enlaces leves, o que pode devolver nós
+            // ao mesmo balde; repete até ele esvaziar
+            rodada++;
+            fronteira.clear();
+            for (size_t k = 0; k < baldes[i].size(); k++) {
+                int v = baldes[i][k];
+                if ((size_t)(rotas.custos[v] / delta) != i || rodadaNaFronteira[v] == rodada) {
+                    continue;
+                }
+                rodadaNaFronteira[v] = rodada;
+                fronteira.push_back(v);
+                if (baldeRemovido[v] != i + 1) {
+                    baldeRemovido[v] = i + 1;
+                    removidos.push_back(v);
+                }
+            }
+            baldes[i].clear();
+            gerarRelaxacoes(fronteira, true, delta, origem, rotas, pedidos, numThreads);
+            for (size_t t = 0; t < pedidos.size(); t++) {
+                for (size_t k = 0; k < pedidos[t].size(); k++) {
+                    const Relaxacao& pedido = pedidos[t][k];
+                    if (pedido.custo < rotas.custos[pedido.no]) {
+                        rotas.custos[pedido.no] = pedido.custo;
+                        rotas.proximosSaltos[pedido.no] = pedido.salto;
+                        size_t balde = (size_t)(pedido.custo / delta);
+                        if (balde >= baldes.size()) {
+                            baldes.resize(balde + 1);
+                        }
+                        baldes[balde].push_back(pedido.no);
+                    }
+                }
+            }
+        }
+
+        // Fase pesada: os custos do balde são finais; enlaces pesados levam a baldes seguintes
+        gerarRelaxacoes(removidos, false, delta, origem, rotas, pedidos, numThreads);
+        for (size_t t = 0; t < pedidos.size(); t++) {
+            for (size_t k = 0; k < pedidos[t].size(); k++) {
+                const Relaxacao& pedido = pedidos[t][k];
+                if (pedido.custo < rotas.custos[pedido.no]) {
+                    rotas.custos[pedido.no] = pedido.custo;
+                    rotas.proximosSaltos[pedido.no] = pedido.salto;
+                    size_t balde = (size_t)(pedido.custo / delta);
+                    if (balde >= baldes.size()) {
+                        baldes.resize(balde + 1);
+                    }
+                    baldes[balde].push_back(pedido.no);
+                }
+            }
+        }
+    }
+}
+
+void SolucionadorReferencia::gerarRelaxacoes(const std::vector<int>& nos, bool leves, double delta, int origem,
+                                             const RotasReferencia& rotas, std::vector<std::vector<Relaxacao>>& pedidos,
+                                             unsigned numThreads) const {
+    // Os pedidos são só gerados em paralelo (leitura dos custos); a aplicação é sequencial
+    size_t partes = std::max((size_t)1, std::min((size_t)numThreads, nos.size() / NOS_POR_THREAD));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < pedidos.size(); t++) {
+        pedidos[t].clear();
+    }
+    for (size_t t = 1; t < partes; t++) {
+        size_t inicio = nos.size() * t / partes;
+        size_t fim = nos.size() * (t + 1) / partes;
+        threads.push_back(std::thread(&SolucionadorReferencia::gerarFaixa, this, nos.data() + inicio, fim - inicio,
+                                      leves, delta, origem, &rotas, &pedidos[t]));
+    }
+    gerarFaixa(nos.data(), nos.size() / partes, leves, delta, origem, &rotas, &pedidos[0]);
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+}
+
+void SolucionadorReferencia::gerarFaixa(const int *nos, size_t numNos, bool leves, double delta, int origem,
+                                        const RotasReferencia *rotas, std::vector<Relaxacao> *pedidos) const {
+    for (size_t i = 0; i < numNos; i++) {
+        int u = nos[i];
+        double custo = rotas->custos[u];
+        int salto = rotas->proximosSaltos[u];
+        for (int k = topologia.inicio[u]; k < topologia.inicio[u + 1]; k++) {
+            if ((topologia.custos[k] <= delta) != leves) {
+                continue;
+            }
+            int v = topologia.alvos[k];
+            double candidato = custo + topologia.custos[k];
+            if (candidato < rotas->custos[v]) {
+                Relaxacao pedido;
+                pedido.no = v;
+                pedido.salto = u == origem ? v : salto;
+                pedido.custo = candidato;
+                pedidos->push_back(pedido);
+            }
+        }
+    }
+}
+
+void SolucionadorReferencia::resolverOrigens(const std::vector<int>& origens, std::vector<RotasReferencia>& rotas,
+                                             unsigned numThreads) const {
+    rotas.resize(origens.size());
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1u, std::min(numThreads, (unsigned)origens.size()));
+
+    // Cada thread retira a próxima origem de um contador comum
+    std::atomic<size_t> proximo(0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; t++) {
+        threads.push_back(std::thread(&SolucionadorReferencia::resolverFaixa, this, &origens, &rotas, &proximo));
+    }
+    resolverFaixa(&origens, &rotas, &proximo);
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+}
+
+void SolucionadorReferencia::resolverFaixa(const std::vector<int> *origens, std::vector<RotasReferencia> *rotas,
+                                           std::atomic<size_t> *proximo) const {
+    HeapRadix heap;
+    for (size_t i = proximo->fetch_add(1); i < origens->size(); i = proximo->fetch_add(1)) {
+        dijkstra((*origens)[i], (*rotas)[i], heap);
+    }
+}
+
+void SolucionadorReferencia::escreverTabela(std::ostream& saida, const std::string& nome, const char *motivo,
+                                            const std::vector<double>& custos, const std::vector<int>& proximosSaltos) {
+    saida << "=== Tabela de Roteamento do Nó " << nome << " (" << motivo << ") ===\n";
+    for (size_t destino = 0; destino < custos.size(); destino++) {
+        if (custos[destino] < CUSTO_INFINITO) {
+            saida << "  Destino: no" << destino << " | Custo: " << custos[destino]
+                  << " | Próximo Salto: no" << proximosSaltos[destino] << "\n";
+        }
+    }
+    saida << "==========================================\n";
+}
@@ -0,0 +1,88 @@
+#ifndef __PROVA_SOLUCIONADORREFERENCIA_H_
+#define __PROVA_SOLUCIONADORREFERENCIA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Solucionador centralizado de caminhos mínimos, usado como oráculo e como referência de
+// desempenho para o PI distribuído. Não depende do OMNeT++: lê a topologia exportada pela
+// simulação (parâmetro arquivoTopologia do Roteador) e escreve as rotas no mesmo formato
+// das tabelas impressas pelo Roteador, para comparação direta com diff.
+//
+// Formato da topologia (texto, uma declaração por linha, '#' inicia comentário):
+//   no <endereco> <nome>
+//   enlace <origem> <destino> <custo em segundos>
+// Enlaces são direcionais; cada ponta exporta o seu sentido.
+
+// Grafo direcional em CSR, indexado por endereço
+struct TopologiaReferencia {
+    std::vector<std::string> nomes;   // Nome de cada endereço ("" = endereço sem nó ativo)
+    std::vector<int> inicio;          // Enlaces de v: alvos[inicio[v]] até alvos[inicio[v + 1] - 1]
+    std::vector<int> alvos;
+    std::vector<double> custos;
+
+    size_t numEnderecos() const { return nomes.size(); }
+    size_t numEnlaces() const { return alvos.size(); }
+    bool ativo(int endereco) const { return !nomes[endereco].empty(); }
+
+    // Lança std::runtime_error com a linha do erro
+    static TopologiaReferencia carregar(std::istream& entrada);
+    static TopologiaReferencia carregar(const std::string& arquivo);
+};
+
+// Custo e primeiro salto de uma origem até cada endereço (SEM_ROTA = inalcançável)
+struct RotasReferencia {
+    std::vector<double> custos;
+    std::vector<int> proximosSaltos;
+};
+
+class HeapRadix;
+
+class SolucionadorReferencia {
+  public:
+    static constexpr int SEM_ROTA = -1;
+
+    explicit SolucionadorReferencia(const TopologiaReferencia& topologia) : topologia(topologia) {}
+
+    // Dijkstra com heap radix (chaves monótonas: os bits de um double não negativo)
+    void dijkstra(int origem, RotasReferencia& rotas) const;
+
+    // Δ-stepping: baldes de largura 'delta'; as relaxações de cada fase são geradas em
+    // paralelo por 'numThreads' threads. 'delta' <= 0 usa maior custo / grau médio
+    void deltaStepping(int origem, double delta, unsigned numThreads, RotasReferencia& rotas) const;
+    double deltaPadrao() const;
+
+    // Vários Dijkstras em paralelo, um por origem; 'rotas[k]' recebe as rotas de 'origens[k]'.
+    // 'numThreads' = 0 usa todos os núcleos
+    void resolverOrigens(const std::vector<int>& origens, std::vector<RotasReferencia>& rotas,
+                         unsigned numThreads = 0) const;
+
+    // Mesmo formato de Roteador::imprimirTabelaRoteamento, sem destinos inalcançáveis
+    static void escreverTabela(std::ostream& saida, const std::string& nome, const char *motivo,
+                               const std::vector<double>& custos, const std::vector<int>& proximosSaltos);
+
+  private:
+    // Pedido de relaxação do Δ-stepping: novo custo e primeiro salto para um nó
+    struct Relaxacao {
+        int no;
+        int salto;
+        double custo;
+    };
+
+    void dijkstra(int origem, RotasReferencia& rotas, HeapRadix& heap) const;
+    void resolverFaixa(const std::vector<int> *origens, std::vector<RotasReferencia> *rotas,
+                       std::atomic<size_t> *proximo) const;
+    void gerarRelaxacoes(const std::vector<int>& nos, bool leves, double delta, int origem,
+                         const RotasReferencia& rotas, std::vector<std::vector<Relaxacao>>& pedidos,
+                         unsigned numThreads) const;
+    void gerarFaixa(const int *nos, size_t numNos, bool leves, double delta, int origem,
+                    const RotasReferencia *rotas, std::vector<Relaxacao> *pedidos) const;
+
+    const TopologiaReferencia& topologia;
+};
+
+#endif
@@ -0,0 +1,102 @@
+// Base de encaminhamento (FIB) plana ou por intervalos, usada pelo plano de dados do Roteador
+
+#include "TabelaEncaminhamento.h"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+void TabelaEncaminhamento::configurar(Formato novoFormato) {
+    formatoAtual = novoFormato;
+    std::vector<uint16_t>().swap(portas);
+    std::vector<int>().swap(inicios);
+    if (formatoAtual == FORMATO_INTERVALOS) {
+        inicios.push_back(0);
+        portas.push_back(CODIGO_SEM_PORTA);
+    }
+}
+
+void TabelaEncaminhamento::definir(int destino, int porta) {
+    if (destino < 0) {
+        throw std::invalid_argument("destino negativo na tabela de encaminhamento");
+    }
+    if (porta > MAIOR_PORTA) {
+        throw std::invalid_argument("porta acima do limite da tabela de encaminhamento (16 bits)");
+    }
+    uint16_t codigo = porta < 0 ? CODIGO_SEM_PORTA : (uint16_t)porta;
+    if (formatoAtual == FORMATO_INTERVALOS) {
+        definirIntervalo(destino, codigo);
+        return;
+    }
+    if ((size_t)destino >= portas.size()) {
+        if (codigo == CODIGO_SEM_PORTA) {
+            return;
+        }
+        portas.resize((size_t)destino + 1, CODIGO_SEM_PORTA);
+    }
+    portas[destino] = codigo;
+}
+
+// Troca a porta de um destino: o intervalo k que o contém vira até três partes (antes, o
+// destino, depois), e a parte do destino absorve os intervalos vizinhos com a mesma porta
+void TabelaEncaminhamento::definirIntervalo(int destino, uint16_t codigo) {
+    size_t k = localizar(destino);
+    uint16_t anterior = portas[k];
+    if (anterior == codigo) {
+        return;
+    }
+    size_t n = inicios.size();
+    bool temAntes = inicios[k] < destino;
+    bool temDepois = (k + 1 < n) ? destino + 1 < inicios[k + 1] : destino < INT_MAX;
+
+    // Trecho [a, b) dos intervalos que será substituído pelas novas partes
+    size_t a = k, b = k + 1;
+    int inicioDestino = destino;
+    if (!temAntes && k > 0 && portas[k - 1] == codigo) {
+        a = k - 1;
+        inicioDestino = inicios[k - 1];
+    }
+    if (!temDepois && k + 1 < n && portas[k + 1] == codigo) {
+        b = k + 2;
+    }
+    int novosInicios[3];
+    uint16_t novasPortas[3];
+    size_t m = 0;
+    if (temAntes) {
+        novosInicios[m] = inicios[k];
+        novasPortas[m++] = anterior;
+    }
+    novosInicios[m] = inicioDestino;
+    novasPortas[m++] = codigo;
+    if (temDepois) {
+        novosInicios[m] = destino + 1;
+        novasPortas[m++] = anterior;
+    }
+
+    if (m > b - a) {
+        inicios.insert(inicios.begin() + b, m - (b - a), 0);
+        portas.insert(portas.begin() + b, m - (b - a), CODIGO_SEM_PORTA);
+    } else if (m < b - a) {
+        inicios.erase(inicios.begin() + a + m, inicios.begin() + b);
+        portas.erase(portas.begin() + a + m, portas.begin() + b);
+    }
+    std::copy(novosInicios, novosInicios + m, inicios.begin() + a);
+    std::copy(novasPortas, novasPortas + m, portas.begin() + a);
+}
+
+size_t TabelaEncaminhamento::numIntervalos() const {
+    if (formatoAtual == FORMATO_INTERVALOS) {
+        return inicios.size();
+    }
+    // Os destinos além do vetor formam o último intervalo, sem porta
+    if (portas.empty()) {
+        return 1;
+    }
+    size_t intervalos = 1;
+    for (size_t i = 1; i < portas.size(); i++) {
+        if (portas[i] != portas[i - 1]) {
+            intervalos++;
+        }
+    }
+    return portas.back() == CODIGO_SEM_PORTA ? intervalos : intervalos + 1;
+}
@@ -0,0 +1,82 @@
+#ifndef __PROVA_TABELAENCAMINHAMENTO_H_
+#define __PROVA_TABELAENCAMINHAMENTO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Base de encaminhamento (FIB) derivada da tabela de roteamento: só a porta de saída de cada
+// destino (índice da tabela), sem custo nem versão. Não depende do OMNeT++. Dois formatos:
+// - plano: uma porta de 16 bits por destino, consulta por índice;
+// - intervalos: destinos contíguos com a mesma porta formam um intervalo (início, porta), e a
+//   consulta é uma busca binária nos inícios. Com endereços numerados com localidade (grade
+//   por linhas, áreas do GeradorTopologia), poucos intervalos cobrem a tabela inteira.
+//
+// A FIB é mantida destino a destino (definir) a cada rota alterada. Nos intervalos, só o
+// intervalo do destino é dividido, e as partes com a mesma porta dos vizinhos são fundidas,
+// então os intervalos vizinhos têm sempre portas diferentes.
+class TabelaEncaminhamento {
+  public:
+    static constexpr int SEM_PORTA = -1;
+    // Maior porta representável (as portas são guardadas em 16 bits)
+    static constexpr int MAIOR_PORTA = 0xFFFE;
+
+    enum Formato {
+        FORMATO_PLANO,
+        FORMATO_INTERVALOS
+    };
+
+    TabelaEncaminhamento() { configurar(FORMATO_PLANO); }
+    // Escolhe o formato e esvazia a FIB (todos os destinos sem porta)
+    void configurar(Formato novoFormato);
+
+    // Porta de saída para o destino (SEM_PORTA = sem rota); lança std::invalid_argument para
+    // destino negativo ou porta acima de MAIOR_PORTA
+    void definir(int destino, int porta);
+
+    int porta(int destino) const {
+        if (destino < 0) {
+            return SEM_PORTA;
+        }
+        uint16_t codigo;
+        if (formatoAtual == FORMATO_PLANO) {
+            codigo = (size_t)destino < portas.size() ? portas[destino] : CODIGO_SEM_PORTA;
+        } else {
+            codigo = portas[localizar(destino)];
+        }
+        return codigo == CODIGO_SEM_PORTA ? SEM_PORTA : codigo;
+    }
+
+    Formato formato() const { return formatoAtual; }
+    // Intervalos com a mesma porta (no formato plano, calculado percorrendo as portas)
+    size_t numIntervalos() const;
+    // Memória alocada para as portas e, nos intervalos, para os inícios
+    size_t bytesOcupados() const {
+        return portas.capacity() * sizeof(uint16_t) + inicios.capacity() * sizeof(int);
+    }
+
+  private:
+    static constexpr uint16_t CODIGO_SEM_PORTA = 0xFFFF;
+
+    // Intervalo que contém o destino: o último início <= destino (busca binária sem desvios;
+    // inicios[0] é sempre 0)
+    size_t localizar(int destino) const {
+        const int *base = inicios.data();
+        size_t n = inicios.size();
+        while (n > 1) {
+            size_t metade = n / 2;
+            base = (base[metade] <= destino) ? base + metade : base;
+            n -= metade;
+        }
+        return base - inicios.data();
+    }
+    void definirIntervalo(int destino, uint16_t codigo);
+
+    Formato formatoAtual;
+    // Plano: porta de cada destino. Intervalos: porta de cada intervalo
+    std::vector<uint16_t> portas;
+    // Intervalos: início de cada um, em ordem crescente; o último vai até o maior int
+    std::vector<int> inicios;
+};
+
+#endif
@@ -0,0 +1,210 @@
+// Tabela de roteamento densa (estrutura de arrays) usada pelo Roteador
+
+#include "TabelaRoteamento.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Kernels vetoriais: compilados com atributo de alvo, sem exigir -mavx2 no build inteiro
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TABELA_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+TabelaRoteamento::Kernel TabelaRoteamento::melhorKernel() {
+    static const Kernel melhor = kernelSuportado(KERNEL_AVX512) ? KERNEL_AVX512
+                               : kernelSuportado(KERNEL_AVX2) ? KERNEL_AVX2
+                               : KERNEL_ESCALAR;
+    return melhor;
+}
+
+bool TabelaRoteamento::kernelSuportado(Kernel kernel) {
+    switch (kernel) {
+        case KERNEL_ESCALAR:
+            return true;
+#ifdef TABELA_SIMD_X86
+        case KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case KERNEL_AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+const char *TabelaRoteamento::nomeKernel(Kernel kernel) {
+    switch (kernel) {
+        case KERNEL_ESCALAR: return "escalar";
+        case KERNEL_AVX2: return "avx2";
+        case KERNEL_AVX512: return "avx512";
+        default: return "?";
+    }
+}
+
+void TabelaRoteamento::usarKernel(Kernel novoKernel) {
+    if (!kernelSuportado(novoKernel)) {
+        throw std::invalid_argument(std::string("kernel de relaxação não suportado pela CPU: ") + nomeKernel(novoKernel));
+    }
+    kernel = novoKernel;
+}
+
+void TabelaRoteamento::reservar(int destino) {
+    size_t necessario = (size_t)destino + 1;
+    if (necessario <= custos.size()) {
+        return;
+    }
+
+    // Cresce geometricamente para amortizar destinos que aparecem em ordem crescente
+    size_t novaCapacidade = custos.size() < 64 ? 64 : custos.size();
+    while (novaCapacidade < necessario) {
+        novaCapacidade *= 2;
+    }
+    custos.resize(novaCapacidade, CUSTO_INFINITO);
+    proximosSaltos.resize(novaCapacidade, SEM_ROTA);
+    versoes.resize(novaCapacidade, 0);
+    conhecidos.resize((novaCapacidade + 63) / 64, 0);
+}
+
+void TabelaRoteamento::definir(int destino, double custo, int proximoSalto) {
+    reservar(destino);
+    uint64_t bit = uint64_t(1) << (destino & 63);
+    if (!(conhecidos[destino >> 6] & bit)) {
+        conhecidos[destino >> 6] |= bit;
+        numConhecidos++;
+    }
+    custos[destino] = custo;
+    proximosSaltos[destino] = proximoSalto;
+}
+
+size_t TabelaRoteamento::relaxar(const int *destinos, const double *custosVizinho, size_t n,
+                                 double custoAteVizinho, int vizinho, std::vector<int>& alterados,
+                                 const int *proximosSaltosVizinho, int saltoExcluido) {
+    size_t antes = alterados.size();
+
+    size_t i = 0;
+    if (kernel == KERNEL_AVX512) {
+        i = relaxarAvx512(destinos, custosVizinho, n, custoAteVizinho, vizinho, alterados,
+                          proximosSaltosVizinho, saltoExcluido);
+    } else if (kernel == KERNEL_AVX2) {
+        i = relaxarAvx2(destinos, custosVizinho, n, custoAteVizinho, vizinho, alterados,
+                        proximosSaltosVizinho, saltoExcluido);
+    }
+
+    // Laço escalar: mensagem inteira sem SIMD, ou as entradas que sobraram dos blocos
+    for (; i < n; i++) {
+        if ((size_t)destinos[i] >= custos.size()) {
+            reservar(destinos[i]);
+        }
+        double novoCusto = custoAteVizinho + custosVizinho[i];
+        // Destinos desconhecidos têm custo infinito; rotas envenenadas nunca melhoram
+        if (novoCusto < custos[destinos[i]]
+            && (proximosSaltosVizinho == nullptr || proximosSaltosVizinho[i] != saltoExcluido)) {
+            atualizarSeMelhor(destinos[i], novoCusto, vizinho, alterados);
+        }
+    }
+    return alterados.size() - antes;
+}
+
+void TabelaRoteamento::atualizarSeMelhor(int destino, double novoCusto, int vizinho, std::vector<int>& alterados) {
+    // Os kernels comparam um bloco inteiro com os custos anteriores a ele: se o mesmo
+    // destino aparece duas vezes no bloco, a segunda lane precisa ser comparada de novo
+    if (novoCusto < custos[destino]) {
+        definir(destino, novoCusto, vizinho);
+        alterados.push_back(destino);
+    }
+}
+
+#ifdef TABELA_SIMD_X86
+
+__attribute__((target("avx2")))
+size_t TabelaRoteamento::relaxarAvx2(const int *destinos, const double *custosVizinho, size_t n,
+                                     double custoAteVizinho, int vizinho, std::vector<int>& alterados,
+                                     const int *proximosSaltosVizinho, int saltoExcluido) {
+    const __m256d base = _mm256_set1_pd(custoAteVizinho);
+    const __m256d todasLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    __m128i limite = _mm_set1_epi32((int)custos.size() - 1);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i indices = _mm_loadu_si128((const __m128i *)(destinos + i));
+        // Destino além da capacidade: cresce a tabela antes do gather
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(indices, limite))) {
+            reservar(*std::max_element(destinos + i, destinos + i + 4));
+            limite = _mm_set1_epi32((int)custos.size() - 1);
+        }
+        // Gather com máscara e origem zerada explícitas: a forma sem máscara passa ao
+        // builtin uma origem indefinida, e o GCC acusa -Wmaybe-uninitialized
+        __m256d atuais = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), custos.data(), indices, todasLanes, 8);
+        __m256d novos = _mm256_add_pd(base, _mm256_loadu_pd(custosVizinho + i));
+        int melhorou = _mm256_movemask_pd(_mm256_cmp_pd(novos, atuais, _CMP_LT_OQ));
+        while (melhorou) {
+            int lane = __builtin_ctz(melhorou);
+            melhorou &= melhorou - 1;
+            // O filtro só é consultado nas lanes que melhoraram, que são raras
+            if (proximosSaltosVizinho != nullptr && proximosSaltosVizinho[i + lane] == saltoExcluido) {
+                continue;
+            }
+            atualizarSeMelhor(destinos[i + lane], custoAteVizinho + custosVizinho[i + lane], vizinho, alterados);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2,avx512f")))
+size_t TabelaRoteamento::relaxarAvx512(const int *destinos, const double *custosVizinho, size_t n,
+                                       double custoAteVizinho, int vizinho, std::vector<int>& alterados,
+                                       const int *proximosSaltosVizinho, int saltoExcluido) {
+    const __m512d base = _mm512_set1_pd(custoAteVizinho);
+    __m256i limite = _mm256_set1_epi32((int)custos.size() - 1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i indices = _mm256_loadu_si256((const __m256i *)(destinos + i));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(indices, limite))) {
+            reservar(*std::max_element(destinos + i, destinos + i + 8));
+            limite = _mm256_set1_epi32((int)custos.size() - 1);
+        }
+        __m512d atuais = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, indices, custos.data(), 8);
+        __m512d novos = _mm512_add_pd(base, _mm512_loadu_pd(custosVizinho + i));
+        unsigned melhorou = _mm512_cmp_pd_mask(novos, atuais, _CMP_LT_OQ);
+        while (melhorou) {
+            int lane = __builtin_ctz(melhorou);
+            melhorou &= melhorou - 1;
+            // O filtro só é consultado nas lanes que melhoraram, que são raras
+            if (proximosSaltosVizinho != nullptr && proximosSaltosVizinho[i + lane] == saltoExcluido) {
+                continue;
+            }
+            atualizarSeMelhor(destinos[i + lane], custoAteVizinho + custosVizinho[i + lane], vizinho, alterados);
+        }
+    }
+    return i;
+}
+
+#else
+
+size_t TabelaRoteamento::relaxarAvx2(const int *, const double *, size_t, double, int, std::vector<int>&,
+                                     const int *, int) {
+    return 0;
+}
+
+size_t TabelaRoteamento::relaxarAvx512(const int *, const double *, size_t, double, int, std::vector<int>&,
+                                       const int *, int) {
+    return 0;
+}
+
+#endif
+
+int TabelaRoteamento::buscarAPartirDe(int destino) const {
+    size_t palavra = (size_t)destino >> 6;
+    if (palavra >= conhecidos.size()) {
+        return SEM_ROTA;
+    }
+    uint64_t bits = conhecidos[palavra] & (~uint64_t(0) << (destino & 63));
+    while (bits == 0) {
+        if (++palavra >= conhecidos.size()) {
+            return SEM_ROTA;
+        }
+        bits = conhecidos[palavra];
+    }
+    return (int)(palavra * 64 + __builtin_ctzll(bits));
+}
@@ -0,0 +1,96 @@
+#ifndef __PROVA_TABELAROTEAMENTO_H_
+#define __PROVA_TABELAROTEAMENTO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Tabela de roteamento densa, indexada pelo número do nó de destino.
+// Estrutura de arrays: custo, próximo salto e versão da última alteração de cada
+// destino, mais um bitset de destinos conhecidos. Destinos desconhecidos têm custo
+// infinito, de modo que a relaxação não precisa tratá-los à parte.
+class TabelaRoteamento {
+  public:
+    static constexpr double CUSTO_INFINITO = std::numeric_limits<double>::infinity();
+    static constexpr int SEM_ROTA = -1;
+
+    // Implementações do laço de relaxação; a padrão é escolhida pela CPU em tempo de execução
+    enum Kernel {
+        KERNEL_ESCALAR,
+        KERNEL_AVX2,    // 4 destinos por iteração (gather + comparação vetorial)
+        KERNEL_AVX512   // 8 destinos por iteração (gather + máscara de comparação)
+    };
+    static Kernel melhorKernel();
+    static bool kernelSuportado(Kernel kernel);
+    static const char *nomeKernel(Kernel kernel);
+
+    // Garante espaço para destinos de 0 até 'destino'
+    void reservar(int destino);
+
+    bool conhece(int destino) const {
+        return destino >= 0 && (size_t)destino < custos.size()
+               && (conhecidos[destino >> 6] >> (destino & 63)) & 1;
+    }
+    double custo(int destino) const {
+        return (destino >= 0 && (size_t)destino < custos.size()) ? custos[destino] : CUSTO_INFINITO;
+    }
+    int proximoSalto(int destino) const {
+        return (destino >= 0 && (size_t)destino < proximosSaltos.size()) ? proximosSaltos[destino] : SEM_ROTA;
+    }
+    unsigned long versao(int destino) const {
+        return (destino >= 0 && (size_t)destino < versoes.size()) ? versoes[destino] : 0;
+    }
+
+    void definir(int destino, double custo, int proximoSalto);
+    void definirVersao(int destino, unsigned long versao) { versoes[destino] = versao; }
+
+    // Número de destinos conhecidos
+    size_t tamanho() const { return numConhecidos; }
+    // Maior número de destino que cabe na tabela + 1
+    size_t capacidade() const { return custos.size(); }
+    // Memória alocada para as entradas (custo, próximo salto, versão e bit de conhecido)
+    size_t bytesOcupados() const {
+        return custos.capacity() * sizeof(double) + proximosSaltos.capacity() * sizeof(int)
+               + versoes.capacity() * sizeof(unsigned long) + conhecidos.capacity() * sizeof(uint64_t);
+    }
+
+    // Percorre os destinos conhecidos em ordem crescente:
+    // for (int d = t.primeiro(); d != SEM_ROTA; d = t.seguinte(d))
+    int primeiro() const { return buscarAPartirDe(0); }
+    int seguinte(int destino) const { return buscarAPartirDe(destino + 1); }
+
+    // Relaxação de Bellman-Ford sobre os arrays da mensagem recebida do vizinho:
+    // custo[d] = min(custo[d], custoAteVizinho + custosVizinho[i]). Os destinos cuja
+    // rota melhorou são acrescentados a 'alterados'; retorna quantos foram.
+    // Com 'proximosSaltosVizinho', entradas cujo próximo salto no vizinho é
+    // 'saltoExcluido' são ignoradas (horizonte dividido aplicado no receptor).
+    size_t relaxar(const int *destinos, const double *custosVizinho, size_t n,
+                   double custoAteVizinho, int vizinho, std::vector<int>& alterados,
+                   const int *proximosSaltosVizinho = nullptr, int saltoExcluido = SEM_ROTA);
+
+    Kernel getKernel() const { return kernel; }
+    // Força uma implementação (benchmarks); deve ser suportada pela CPU
+    void usarKernel(Kernel novoKernel);
+
+  private:
+    int buscarAPartirDe(int destino) const;
+    void atualizarSeMelhor(int destino, double novoCusto, int vizinho, std::vector<int>& alterados);
+    // Processam blocos completos de lanes e retornam quantas entradas consumiram
+    size_t relaxarAvx2(const int *destinos, const double *custosVizinho, size_t n,
+                       double custoAteVizinho, int vizinho, std::vector<int>& alterados,
+                       const int *proximosSaltosVizinho, int saltoExcluido);
+    size_t relaxarAvx512(const int *destinos, const double *custosVizinho, size_t n,
+                         double custoAteVizinho, int vizinho, std::vector<int>& alterados,
+                         const int *proximosSaltosVizinho, int saltoExcluido);
+
+    Kernel kernel = melhorKernel();
+
+    std::vector<double> custos;
+    std::vector<int> proximosSaltos;
+    std::vector<unsigned long> versoes;
+    std::vector<uint64_t> conhecidos;
+    size_t numConhecidos = 0;
+};
+
+#endif
@@ -0,0 +1,326 @@
+// Validação global das rotas convergidas contra um Dijkstra central, paralela por destino
+
+#include "ValidadorRoteamento.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+// Estado de um nó no percurso dos próximos saltos de um destino
+static const unsigned char NAO_VISITADO = 0;
+static const unsigned char NA_PILHA = 1;
+static const unsigned char RESOLVIDO = 2;
+
+// Desfecho de seguir os próximos saltos a partir de um nó
+static const unsigned char CHEGA = 0;
+static const unsigned char EM_LACO = 1;
+static const unsigned char INTERROMPIDA = 2;
+
+// Erro relativo tolerado na soma dos custos em ordens diferentes
+static const double ERRO_RELATIVO = 1e-9;
+
+// Ordem por origem, destino e custo (o mais barato dos paralelos primeiro)
+bool ValidadorRoteamento::enlaceMenor(const Enlace& a, const Enlace& b) {
+    if (a.origem != b.origem) {
+        return a.origem < b.origem;
+    }
+    if (a.destino != b.destino) {
+        return a.destino < b.destino;
+    }
+    return a.custo < b.custo;
+}
+
+bool ValidadorRoteamento::mesmoEnlace(const Enlace& a, const Enlace& b) {
+    return a.origem == b.origem && a.destino == b.destino;
+}
+
+void ValidadorRoteamento::Resultado::acumular(const Resultado& outro) {
+    rotasVerificadas += outro.rotasVerificadas;
+    rotasOtimas += outro.rotasOtimas;
+    rotasSubotimas += outro.rotasSubotimas;
+    rotasEmLaco += outro.rotasEmLaco;
+    rotasInterrompidas += outro.rotasInterrompidas;
+    custosDivergentes += outro.custosDivergentes;
+    maiorExcesso = std::max(maiorExcesso, outro.maiorExcesso);
+    rotasMedidas += outro.rotasMedidas;
+    somaEstiramentos += outro.somaEstiramentos;
+    maiorEstiramento = std::max(maiorEstiramento, outro.maiorEstiramento);
+}
+
+void ValidadorRoteamento::adicionarNo(int endereco, const TabelaRoteamento *tabela) {
+    if (endereco < 0 || tabela == nullptr) {
+        throw std::invalid_argument("ValidadorRoteamento: nó com endereço negativo ou sem tabela");
+    }
+    if ((size_t)endereco >= tabelas.size()) {
+        tabelas.resize(endereco + 1, nullptr);
+    }
+    tabelas[endereco] = tabela;
+}
+
+void ValidadorRoteamento::adicionarNoInativo(int endereco) {
+    if (endereco < 0) {
+        throw std::invalid_argument("ValidadorRoteamento: nó com endereço negativo");
+    }
+    if ((size_t)endereco >= tabelas.size()) {
+        tabelas.resize(endereco + 1, nullptr);
+    }
+    inativos.push_back(endereco);
+}
+
+void ValidadorRoteamento::adicionarEnlace(int origem, int destino, double custo) {
+    if (origem < 0 || destino < 0) {
+        throw std::invalid_argument("ValidadorRoteamento: enlace com endereço negativo");
+    }
+    Enlace enlace;
+    enlace.origem = origem;
+    enlace.destino = destino;
+    enlace.custo = custo;
+    enlaces.push_back(enlace);
+}
+
+void ValidadorRoteamento::definirAreas(int tamanho) {
+    if (tamanho < 0) {
+        throw std::invalid_argument("ValidadorRoteamento: tamanho de área negativo");
+    }
+    tamanhoArea = tamanho;
+}
+
+void ValidadorRoteamento::amostrarDestinos(size_t numDestinos) {
+    maximoDestinos = numDestinos;
+}
+
+void ValidadorRoteamento::montarGrafos(Grafo& direto, Grafo& reverso) const {
+    // Enlaces entre nós ativos, ordenados por origem e destino; dos paralelos fica o mais barato
+    std::vector<Enlace> ativos;
+    ativos.reserve(enlaces.size());
+    for (size_t i = 0; i < enlaces.size(); i++) {
+        const Enlace& enlace = enlaces[i];
+        if ((size_t)enlace.origem < tabelas.size() && (size_t)enlace.destino < tabelas.size()
+            && tabelas[enlace.origem] != nullptr && tabelas[enlace.destino] != nullptr
+            && enlace.origem != enlace.destino) {
+            ativos.push_back(enlace);
+        }
+    }
+    std::sort(ativos.begin(), ativos.end(), enlaceMenor);
+    ativos.erase(std::unique(ativos.begin(), ativos.end(), mesmoEnlace), ativos.end());
+
+    size_t numNos = tabelas.size();
+    direto.inicio.assign(numNos + 1, 0);
+    reverso.inicio.assign(numNos + 1, 0);
+    for (size_t i = 0; i < ativos.size(); i++) {
+        direto.inicio[ativos[i].origem + 1]++;
+        reverso.inicio[ativos[i].destino + 1]++;
+    }
+    for (size_t v = 0; v < numNos; v++) {
+        direto.inicio[v + 1] += direto.inicio[v];
+        reverso.inicio[v + 1] += reverso.inicio[v];
+    }
+    direto.alvos.resize(ativos.size());
+    direto.custos.resize(ativos.size());
+    reverso.alvos.resize(ativos.size());
+    reverso.custos.resize(ativos.size());
+    std::vector<int> posicao(reverso.inicio.begin(), reverso.inicio.end() - 1);
+    for (size_t i = 0; i < ativos.size(); i++) {
+        // Em ordem de origem e destino: as listas diretas ficam ordenadas (busca binária no percurso)
+        direto.alvos[i] = ativos[i].destino;
+        direto.custos[i] = ativos[i].custo;
+        int j = posicao[ativos[i].destino]++;
+        reverso.alvos[j] = ativos[i].origem;
+        reverso.custos[j] = ativos[i].custo;
+    }
+}
+
+ValidadorRoteamento::Resultado ValidadorRoteamento::validar(double tolerancia, unsigned numThreads) const {
+    Grafo direto, reverso;
+    montarGrafos(direto, reverso);
+
+    // Destinos: os nós ativos e os inativos
+    std::vector<int> destinos;
+    for (size_t v = 0; v < tabelas.size(); v++) {
+        if (tabelas[v] != nullptr) {
+            destinos.push_back(v);
+        }
+    }
+    destinos.insert(destinos.end(), inativos.begin(), inativos.end());
+    std::sort(destinos.begin(), destinos.end());
+    destinos.erase(std::unique(destinos.begin(), destinos.end()), destinos.end());
+    if (maximoDestinos > 0 && maximoDestinos < destinos.size()) {
+        std::vector<int> amostra(maximoDestinos);
+        for (size_t i = 0; i < maximoDestinos; i++) {
+            amostra[i] = destinos[i * destinos.size() / maximoDestinos];
+        }
+        destinos.swap(amostra);
+    }
+
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1u, std::min(numThreads, (unsigned)destinos.size()));
+
+    // Cada thread retira o próximo destino de um contador comum e acumula um resultado próprio
+    std::atomic<size_t> proximo(0);
+    std::vector<Resultado> parciais(numThreads);
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; t++) {
+        threads.push_back(std::thread(&ValidadorRoteamento::validarFaixa, this, &destinos, &direto, &reverso,
+                                      tolerancia, &proximo, &parciais[t]));
+    }
+    validarFaixa(&destinos, &direto, &reverso, tolerancia, &proximo, &parciais[0]);
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+
+    Resultado total;
+    for (size_t t = 0; t < parciais.size(); t++) {
+        total.acumular(parciais[t]);
+    }
+    return total;
+}
+
+void ValidadorRoteamento::validarFaixa(const std::vector<int> *destinos, const Grafo *direto, const Grafo *reverso,
+                                       double tolerancia, std::atomic<size_t> *proximo, Resultado *resultado) const {
+    Area area;
+    size_t numNos = tabelas.size();
+    area.distancias.resize(numNos);
+    area.estados.resize(numNos);
+    area.desfechos.resize(numNos);
+    area.custosEncaminhados.resize(numNos);
+    area.custosSalto.resize(numNos);
+    for (size_t i = proximo->fetch_add(1); i < destinos->size(); i = proximo->fetch_add(1)) {
+        validarDestino((*destinos)[i], *direto, *reverso, tolerancia, area, *resultado);
+    }
+}
+
+void ValidadorRoteamento::validarDestino(int destino, const Grafo& direto, const Grafo& reverso, double tolerancia,
+                                         Area& area, Resultado& resultado) const {
+    const double infinito = TabelaRoteamento::CUSTO_INFINITO;
+    size_t numNos = tabelas.size();
+
+    // Custo ótimo de cada nó até o destino: Dijkstra a partir dele no grafo reverso
+    std::vector<double>& distancias = area.distancias;
+    std::fill(distancias.begin(), distancias.end(), infinito);
+    std::vector<std::pair<double, int>>& heap = area.heap;
+    std::greater<std::pair<double, int>> maior;
+    heap.clear();
+    distancias[destino] = 0;
+    heap.push_back(std::make_pair(0.0, destino));
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), maior);
+        double distancia = heap.back().first;
+        int v = heap.back().second;
+        heap.pop_back();
+        if (distancia > distancias[v]) {
+            continue;
+        }
+        for (int k = reverso.inicio[v]; k < reverso.inicio[v + 1]; k++) {
+            int u = reverso.alvos[k];
+            double candidato = distancia + reverso.custos[k];
+            if (candidato < distancias[u]) {
+                distancias[u] = candidato;
+                heap.push_back(std::make_pair(candidato, u));
+                std::push_heap(heap.begin(), heap.end(), maior);
+            }
+        }
+    }
+
+    // Segue os próximos saltos de cada nó até um nó já resolvido, o destino, um salto
+    // inválido ou um nó já na pilha (laço); o desfecho vale para toda a pilha
+    std::vector<unsigned char>& estados = area.estados;
+    std::vector<unsigned char>& desfechos = area.desfechos;
+    std::vector<double>& custosEncaminhados = area.custosEncaminhados;
+    std::vector<double>& custosSalto = area.custosSalto;
+    std::vector<int>& pilha = area.pilha;
+    std::fill(estados.begin(), estados.end(), NAO_VISITADO);
+    estados[destino] = RESOLVIDO;
+    desfechos[destino] = CHEGA;
+    custosEncaminhados[destino] = 0;
+
+    for (size_t origem = 0; origem < numNos; origem++) {
+        if (tabelas[origem] == nullptr || estados[origem] != NAO_VISITADO) {
+            continue;
+        }
+        pilha.clear();
+        int v = origem;
+        unsigned char desfecho;
+        double custoFinal = 0;
+        while (true) {
+            if (estados[v] == RESOLVIDO) {
+                desfecho = desfechos[v];
+                custoFinal = custosEncaminhados[v];
+                break;
+            }
+            if (estados[v] == NA_PILHA) {
+                desfecho = EM_LACO;
+                break;
+            }
+            estados[v] = NA_PILHA;
+            pilha.push_back(v);
+
+            const TabelaRoteamento& tabela = *tabelas[v];
+            int indice = chave(v, destino);
+            int salto = tabela.custo(indice) < infinito ? tabela.proximoSalto(indice) : TabelaRoteamento::SEM_ROTA;
+            const int *primeiro = direto.alvos.data() + direto.inicio[v];
+            const int *ultimo = direto.alvos.data() + direto.inicio[v + 1];
+            const int *enlace = salto >= 0 ? std::lower_bound(primeiro, ultimo, salto) : ultimo;
+            if (enlace == ultimo || *enlace != salto) {
+                // Sem rota, ou o próximo salto não é vizinho ativo
+                desfecho = INTERROMPIDA;
+                custoFinal = infinito;
+                pilha.pop_back();
+                estados[v] = RESOLVIDO;
+                desfechos[v] = INTERROMPIDA;
+                custosEncaminhados[v] = infinito;
+                break;
+            }
+            custosSalto[v] = direto.custos[enlace - direto.alvos.data()];
+            v = salto;
+        }
+        for (size_t i = pilha.size(); i-- > 0;) {
+            int u = pilha[i];
+            if (desfecho == CHEGA) {
+                custoFinal += custosSalto[u];
+            }
+            estados[u] = RESOLVIDO;
+            desfechos[u] = desfecho;
+            custosEncaminhados[u] = desfecho == CHEGA ? custoFinal : infinito;
+        }
+    }
+
+    // Classificação das rotas de todas as origens para este destino
+    for (size_t origem = 0; origem < numNos; origem++) {
+        if (tabelas[origem] == nullptr || (int)origem == destino) {
+            continue;
+        }
+        resultado.rotasVerificadas++;
+        double otimo = distancias[origem];
+        double custoTabela = tabelas[origem]->custo(chave(origem, destino));
+        double margem = tolerancia + ERRO_RELATIVO * (std::isfinite(otimo) ? otimo : 0);
+
+        if (tamanhoArea <= 0
+            && (otimo == infinito ? custoTabela != infinito : std::fabs(custoTabela - otimo) > margem)) {
+            resultado.custosDivergentes++;
+        }
+
+        if (otimo == infinito && custoTabela == infinito) {
+            // Inalcançável e a tabela sabe disso
+            resultado.rotasOtimas++;
+        } else if (desfechos[origem] == EM_LACO) {
+            resultado.rotasEmLaco++;
+        } else if (desfechos[origem] == INTERROMPIDA) {
+            resultado.rotasInterrompidas++;
+        } else if (custosEncaminhados[origem] > otimo + margem) {
+            resultado.rotasSubotimas++;
+            resultado.maiorExcesso = std::max(resultado.maiorExcesso, custosEncaminhados[origem] - otimo);
+        } else {
+            resultado.rotasOtimas++;
+        }
+        if (desfechos[origem] == CHEGA && otimo > 0 && otimo < infinito) {
+            double estiramento = custosEncaminhados[origem] / otimo;
+            resultado.rotasMedidas++;
+            resultado.somaEstiramentos += estiramento;
+            resultado.maiorEstiramento = std::max(resultado.maiorEstiramento, estiramento);
+        }
+    }
+}
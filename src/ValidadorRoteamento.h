@@ -0,0 +1,108 @@
+#ifndef __PROVA_VALIDADORROTEAMENTO_H_
+#define __PROVA_VALIDADORROTEAMENTO_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TabelaRoteamento.h"
+
+// Validação global das tabelas de roteamento após a convergência, comparada a um
+// Dijkstra central. Não depende do OMNeT++: recebe os nós ativos com suas tabelas e os
+// enlaces direcionais ativos com seus custos.
+//
+// O trabalho é feito por destino: um Dijkstra no grafo reverso dá o custo ótimo de
+// todos os nós até o destino, e os próximos saltos das tabelas formam um grafo funcional
+// percorrido uma única vez, de modo que cada rota é classificada sem refazer o caminho
+// de cada origem. Os destinos são repartidos entre threads, cada uma com memória O(N);
+// a matriz de custos de todos os pares nunca é montada.
+//
+// Com roteamento hierárquico (definirAreas), cada tabela é consultada pelo índice que o
+// próprio nó usa para o destino: o endereço dentro da área, ou a entrada resumida da área
+// do destino. As rotas continuam seguidas salto a salto até o destino, e o estiramento
+// (custo encaminhado / ótimo) mede o quanto o resumo das áreas as alonga.
+class ValidadorRoteamento {
+  public:
+    struct Resultado {
+        int64_t rotasVerificadas = 0;    // Pares (origem ativa, destino) distintos
+        int64_t rotasOtimas = 0;         // Chega ao destino pelo custo ótimo (ou ambos inalcançáveis)
+        int64_t rotasSubotimas = 0;      // Chega ao destino por um caminho mais caro que o ótimo
+        int64_t rotasEmLaco = 0;         // Os próximos saltos entram em um ciclo sem passar pelo destino
+        int64_t rotasInterrompidas = 0;  // Sem rota, ou um salto sem enlace ativo, no caminho até o destino
+        int64_t custosDivergentes = 0;   // Custo na tabela da origem diferente do ótimo
+        double maiorExcesso = 0;         // Maior custo encaminhado além do ótimo
+        int64_t rotasMedidas = 0;        // Rotas que chegam ao destino com ótimo positivo (base do estiramento)
+        double somaEstiramentos = 0;     // Soma de custo encaminhado / ótimo dessas rotas
+        double maiorEstiramento = 1;
+
+        void acumular(const Resultado& outro);
+        int64_t rotasIncorretas() const { return rotasSubotimas + rotasEmLaco + rotasInterrompidas; }
+        double estiramentoMedio() const { return rotasMedidas > 0 ? somaEstiramentos / rotasMedidas : 1; }
+    };
+
+    // Nó ativo; a tabela é só lida e deve continuar válida até o fim de validar()
+    void adicionarNo(int endereco, const TabelaRoteamento *tabela);
+    // Nó que falhou: não tem rotas nem enlaces, mas as rotas dos demais até ele também são
+    // verificadas (o esperado é que seja inalcançável)
+    void adicionarNoInativo(int endereco);
+    // Enlace ativo de 'origem' para 'destino'; entre enlaces paralelos vale o mais barato
+    void adicionarEnlace(int origem, int destino, double custo);
+
+    // Roteamento hierárquico: áreas de 'tamanhoArea' endereços consecutivos (0 = plano). Os
+    // custos das tabelas deixam de ser comparados ao ótimo (o de uma área é o custo até ela)
+    void definirAreas(int tamanhoArea);
+    // Valida só 'numDestinos' destinos espaçados uniformemente entre os endereços (0 = todos);
+    // todas as origens são verificadas para cada um
+    void amostrarDestinos(size_t numDestinos);
+
+    // 'tolerancia': diferença absoluta de custo aceita (p. ex. custos quantizados na rede),
+    // além do erro relativo de arredondamento. 'numThreads' = 0 usa todos os núcleos
+    Resultado validar(double tolerancia = 0, unsigned numThreads = 0) const;
+
+  private:
+    // Grafo em CSR: vizinhos do nó v em alvos[inicio[v]] até alvos[inicio[v + 1] - 1]
+    struct Grafo {
+        std::vector<int> inicio;
+        std::vector<int> alvos;
+        std::vector<double> custos;
+    };
+    struct Enlace {
+        int origem;
+        int destino;
+        double custo;
+    };
+    // Estado de trabalho de uma thread, reaproveitado entre destinos
+    struct Area {
+        std::vector<double> distancias;
+        std::vector<std::pair<double, int>> heap;
+        std::vector<unsigned char> estados;
+        std::vector<unsigned char> desfechos;
+        std::vector<double> custosEncaminhados;
+        std::vector<double> custosSalto;
+        std::vector<int> pilha;
+    };
+
+    // Índice da tabela de 'no' para o endereço 'destino'
+    int chave(int no, int destino) const {
+        if (tamanhoArea <= 0) {
+            return destino;
+        }
+        int areaDestino = destino / tamanhoArea;
+        return areaDestino == no / tamanhoArea ? destino % tamanhoArea : tamanhoArea + areaDestino;
+    }
+    static bool enlaceMenor(const Enlace& a, const Enlace& b);
+    static bool mesmoEnlace(const Enlace& a, const Enlace& b);
+    void montarGrafos(Grafo& direto, Grafo& reverso) const;
+    void validarDestino(int destino, const Grafo& direto, const Grafo& reverso, double tolerancia,
+                        Area& area, Resultado& resultado) const;
+    void validarFaixa(const std::vector<int> *destinos, const Grafo *direto, const Grafo *reverso,
+                      double tolerancia, std::atomic<size_t> *proximo, Resultado *resultado) const;
+
+    std::vector<const TabelaRoteamento *> tabelas;   // Indexado por endereço (nullptr = ausente ou inativo)
+    std::vector<int> inativos;
+    std::vector<Enlace> enlaces;
+    int tamanhoArea = 0;
+    size_t maximoDestinos = 0;
+};
+
+#endif